@@ -0,0 +1,113 @@
+#ifndef TINY_BENCH_HPP
+#define TINY_BENCH_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <mutex>
+#include <optional>
+#include <sched.h>
+#include <string>
+
+namespace Tiny {
+namespace Bench {
+// keep a value alive so the optimizer cannot drop the work producing it
+template <typename T> inline void keep(const T &value) {
+  asm volatile("" : : "r,m"(value) : "memory");
+}
+
+// best wall time of reps runs of f, in nanoseconds
+template <typename F> double best_ns(F &&f, int reps = 5) {
+  double best = 0;
+  for (int r = 0; r < reps; r++) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    auto stop = std::chrono::steady_clock::now();
+    double ns = std::chrono::duration<double, std::nano>(stop - start).count();
+    if (r == 0 || ns < best) {
+      best = ns;
+    }
+  }
+  return best;
+}
+
+inline void report(const std::string &name, double ns, double items,
+                   const std::string &unit = "elem") {
+  std::cout << std::left << std::setw(40) << name << std::right
+            << std::setw(12) << std::fixed << std::setprecision(3)
+            << ns / items << " ns/" << unit << std::endl;
+}
+
+// amount / ns, e.g. floating point operations per ns is GFLOP/s
+inline void report_rate(const std::string &name, double ns, double amount,
+                        const std::string &unit) {
+  std::cout << std::left << std::setw(40) << name << std::right
+            << std::setw(12) << std::fixed << std::setprecision(3)
+            << amount / ns << ' ' << unit << std::endl;
+}
+
+// a Queue or Stack behind one mutex, the baseline the lock-free containers
+// are measured against; bounded like them when given a capacity
+template <typename T, typename Container> class Locked {
+public:
+  explicit Locked(
+      std::size_t capacity = std::numeric_limits<std::size_t>::max())
+      : capacity_(capacity) {}
+
+  bool try_push(const T &value) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (container_.size() == capacity_) {
+      return false;
+    }
+    container_.push(value);
+    return true;
+  }
+
+  bool try_pop(T &out) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (container_.empty()) {
+      return false;
+    }
+    if constexpr (requires { container_.front(); }) {
+      out = container_.front();
+    } else {
+      out = container_.top();
+    }
+    container_.pop();
+    return true;
+  }
+
+  std::optional<T> try_pop() {
+    T value;
+    if (!try_pop(value)) {
+      return std::nullopt;
+    }
+    return value;
+  }
+
+  // poll with a yield, the mutex has nothing to park on
+  void push(const T &value) {
+    while (!try_push(value)) {
+      sched_yield();
+    }
+  }
+
+  T pop() {
+    T value;
+    while (!try_pop(value)) {
+      sched_yield();
+    }
+    return value;
+  }
+
+private:
+  std::mutex mutex_;
+  Container container_;
+  std::size_t capacity_;
+};
+} // namespace Bench
+} // namespace Tiny
+
+#endif // TINY_BENCH_HPP
@@ -0,0 +1,128 @@
+#include "Bench.hpp"
+#include "ConcurrentQueue.hpp"
+#include "Queue.hpp"
+#include "Thread.hpp"
+#include <mutex>
+#include <sched.h>
+#include <string>
+#include <unistd.h>
+
+namespace {
+// what consumers do today: a mutex-guarded Queue polled through empty(),
+// sleeping between polls or just yielding the cpu
+class PolledQueue {
+public:
+  explicit PolledQueue(useconds_t nap) : nap_(nap) {}
+
+  void push(long value) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    queue_.push(value);
+  }
+
+  long pop() {
+    for (;;) {
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!queue_.empty()) {
+          long value = queue_.front();
+          queue_.pop();
+          return value;
+        }
+      }
+      if (nap_ != 0) {
+        usleep(nap_);
+      } else {
+        sched_yield();
+      }
+    }
+  }
+
+private:
+  std::mutex mutex_;
+  Tiny::Queue<long, Tiny::Deque<long>> queue_;
+  useconds_t nap_;
+};
+
+long pop(PolledQueue &queue) { return queue.pop(); }
+long pop(Tiny::BlockingQueue<long> &queue) { return *queue.pop(); }
+
+// a message goes out and is echoed back, the time per trip is two
+// wake-ups of a waiting consumer
+template <typename Q> void ping_pong(Q &there, Q &back, long trips) {
+  Tiny::Thread echo([&there, &back, trips] {
+    for (long i = 0; i < trips; i++) {
+      back.push(pop(there));
+    }
+  });
+  for (long i = 0; i < trips; i++) {
+    there.push(i);
+    Tiny::Bench::keep(pop(back));
+  }
+  echo.join();
+}
+
+// one producer streams count values to one consumer
+void stream(Tiny::BlockingQueue<long> &queue, long count, bool batched) {
+  Tiny::Thread producer([&queue, count] {
+    for (long i = 0; i < count; i++) {
+      queue.push(i);
+    }
+    queue.close();
+  });
+  long sum = 0;
+  if (batched) {
+    Tiny::Deque<long> batch;
+    while (queue.pop_all(batch) != 0) {
+      for (long value : batch) {
+        sum += value;
+      }
+    }
+  } else {
+    while (std::optional<long> value = queue.pop()) {
+      sum += *value;
+    }
+  }
+  producer.join();
+  Tiny::Bench::keep(sum);
+}
+} // namespace
+
+int main() {
+  const long trips = 1 << 12;
+  const long count = 1 << 20;
+  std::cout << "Tiny::BlockingQueue vs polling a mutex + Tiny::Queue, "
+            << std::thread::hardware_concurrency() << " cpus" << std::endl;
+
+  using namespace Tiny;
+  Bench::report("round trip poll, 100us naps", Bench::best_ns(
+                                                   [&] {
+                                                     PolledQueue there(100);
+                                                     PolledQueue back(100);
+                                                     ping_pong(there, back,
+                                                               trips / 16);
+                                                   },
+                                                   3),
+                trips / 16, "trip");
+  Bench::report("round trip poll, yielding", Bench::best_ns([&] {
+                  PolledQueue there(0), back(0);
+                  ping_pong(there, back, trips);
+                }),
+                trips, "trip");
+  Bench::report("round trip BlockingQueue", Bench::best_ns([&] {
+                  BlockingQueue<long> there, back;
+                  ping_pong(there, back, trips);
+                }),
+                trips, "trip");
+
+  Bench::report("stream BlockingQueue pop", Bench::best_ns([&] {
+                  BlockingQueue<long> queue;
+                  stream(queue, count, false);
+                }),
+                count, "msg");
+  Bench::report("stream BlockingQueue pop_all", Bench::best_ns([&] {
+                  BlockingQueue<long> queue;
+                  stream(queue, count, true);
+                }),
+                count, "msg");
+  return 0;
+}
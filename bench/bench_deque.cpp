@@ -0,0 +1,69 @@
+#include "Bench.hpp"
+#include "List.hpp"
+#include "Queue.hpp"
+#include <deque>
+
+namespace {
+// a sliding window: keep window elements, push one and pop one per step
+// values are pushed as temporaries, List::push_back only takes rvalues
+template <typename Q> void slide(Q &queue, long window, long steps) {
+  for (long i = 0; i < window; i++) {
+    queue.push_back(long(i));
+  }
+  long sum = 0;
+  for (long i = 0; i < steps; i++) {
+    queue.push_back(long(i));
+    sum += queue.front();
+    queue.pop_front();
+  }
+  Tiny::Bench::keep(sum);
+}
+
+template <typename Q> long index_sum(const Q &queue) {
+  long sum = 0;
+  for (std::size_t i = 0; i < queue.size(); i++) {
+    sum += queue[i];
+  }
+  return sum;
+}
+} // namespace
+
+int main() {
+  const long steps = 1 << 22;
+  std::cout << "Tiny::Deque vs Tiny::List and std::deque, " << steps
+            << " push_back/pop_front steps" << std::endl;
+
+  using namespace Tiny;
+  for (long window : {16L, 1024L, 65536L}) {
+    const std::string suffix = " window " + std::to_string(window);
+    Bench::report("slide List" + suffix, Bench::best_ns([&] {
+                    List<long> queue;
+                    slide(queue, window, steps);
+                  }),
+                  steps, "step");
+    Bench::report("slide std::deque" + suffix, Bench::best_ns([&] {
+                    std::deque<long> queue;
+                    slide(queue, window, steps);
+                  }),
+                  steps, "step");
+    Bench::report("slide Deque" + suffix, Bench::best_ns([&] {
+                    Deque<long> queue;
+                    slide(queue, window, steps);
+                  }),
+                  steps, "step");
+  }
+
+  Deque<long> deque;
+  std::deque<long> reference;
+  for (long i = 0; i < steps; i++) {
+    deque.push_back(i);
+    reference.push_back(i);
+  }
+  Bench::report("operator[] std::deque",
+                Bench::best_ns([&] { Bench::keep(index_sum(reference)); }),
+                steps);
+  Bench::report("operator[] Deque",
+                Bench::best_ns([&] { Bench::keep(index_sum(deque)); }),
+                steps);
+  return 0;
+}
@@ -0,0 +1,118 @@
+#include "Bench.hpp"
+#include "Queue.hpp"
+#include "Vector.hpp"
+#include <limits>
+#include <random>
+#include <string>
+#include <utility>
+
+namespace {
+// a graph in compressed rows: the edges of node u are
+// targets[offsets[u]] .. targets[offsets[u + 1]]
+struct Graph {
+  Tiny::Vector<std::size_t> offsets;
+  Tiny::Vector<std::size_t> targets;
+  Tiny::Vector<long> weights;
+
+  std::size_t nodes() const { return offsets.size() - 1; }
+};
+
+Graph random_graph(std::size_t nodes, std::size_t degree) {
+  std::mt19937_64 rng(7);
+  Graph graph;
+  graph.offsets.push_back(0);
+  for (std::size_t u = 0; u < nodes; u++) {
+    for (std::size_t e = 0; e < degree; e++) {
+      graph.targets.push_back(rng() % nodes);
+      graph.weights.push_back(static_cast<long>(rng() % 1000) + 1);
+    }
+    graph.offsets.push_back(graph.targets.size());
+  }
+  return graph;
+}
+
+constexpr long unreached = std::numeric_limits<long>::max();
+
+// what the routing service does today: push a duplicate on every
+// improvement and skip stale entries when they surface
+long lazy_dijkstra(const Graph &graph, std::size_t &peak) {
+  Tiny::Vector<long> dist(graph.nodes(), unreached);
+  Tiny::Priority_Queue<std::pair<long, std::size_t>> queue;
+  dist[0] = 0;
+  queue.push({0, 0});
+  peak = 1;
+  while (!queue.empty()) {
+    const auto [d, u] = queue.top();
+    queue.pop();
+    if (d != dist[u]) {
+      continue;
+    }
+    for (std::size_t e = graph.offsets[u]; e < graph.offsets[u + 1]; e++) {
+      const std::size_t v = graph.targets[e];
+      if (d + graph.weights[e] < dist[v]) {
+        dist[v] = d + graph.weights[e];
+        queue.push({dist[v], v});
+        peak = std::max(peak, queue.size());
+      }
+    }
+  }
+  return dist[graph.nodes() - 1];
+}
+
+long indexed_dijkstra(const Graph &graph, std::size_t &peak) {
+  Tiny::Vector<long> dist(graph.nodes(), unreached);
+  Tiny::Indexed_Priority_Queue<long> queue(graph.nodes());
+  dist[0] = 0;
+  queue.push(0, 0);
+  peak = 1;
+  while (!queue.empty()) {
+    const std::size_t u = queue.top();
+    const long d = queue.top_key();
+    queue.pop();
+    for (std::size_t e = graph.offsets[u]; e < graph.offsets[u + 1]; e++) {
+      const std::size_t v = graph.targets[e];
+      if (d + graph.weights[e] < dist[v]) {
+        const bool queued = dist[v] != unreached;
+        dist[v] = d + graph.weights[e];
+        if (queued) {
+          queue.decrease_key(v, dist[v]);
+        } else {
+          queue.push(v, dist[v]);
+          peak = std::max(peak, queue.size());
+        }
+      }
+    }
+  }
+  return dist[graph.nodes() - 1];
+}
+} // namespace
+
+int main() {
+  std::cout << "Dijkstra, lazy Priority_Queue vs Indexed_Priority_Queue"
+            << std::endl;
+
+  using namespace Tiny;
+  for (std::size_t nodes : {std::size_t(1) << 14, std::size_t(1) << 20}) {
+    for (std::size_t degree : {4, 16}) {
+      const Graph graph = random_graph(nodes, degree);
+      const std::string suffix =
+          " n=" + std::to_string(nodes) + " d=" + std::to_string(degree);
+      std::size_t lazy_peak = 0;
+      std::size_t indexed_peak = 0;
+      long lazy = 0;
+      long indexed = 0;
+      Bench::report("lazy Priority_Queue" + suffix,
+                    Bench::best_ns(
+                        [&] { lazy = lazy_dijkstra(graph, lazy_peak); }, 3),
+                    nodes, "node");
+      Bench::report(
+          "Indexed_Priority_Queue" + suffix,
+          Bench::best_ns(
+              [&] { indexed = indexed_dijkstra(graph, indexed_peak); }, 3),
+          nodes, "node");
+      std::cout << "  peak heap " << lazy_peak << " vs " << indexed_peak
+                << (lazy == indexed ? "" : ", DISTANCES DIFFER") << std::endl;
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,98 @@
+#include "Bench.hpp"
+#include "Expr.hpp"
+#include "Vector.hpp"
+
+namespace {
+using Floats = Tiny::Vector<float>;
+
+void loop_axpy(Floats &dst, const Floats &x, const Floats &y, float a) {
+  for (std::size_t i = 0; i < dst.size(); i++) {
+    dst[i] = a * x[i] + y[i];
+  }
+}
+
+void expr_axpy(Floats &dst, const Floats &x, const Floats &y, float a) {
+  using namespace Tiny::Expr;
+  assign(dst, a * x + y);
+}
+
+void loop_mix(Floats &dst, const Floats &x, const Floats &y,
+              const Floats &z) {
+  for (std::size_t i = 0; i < dst.size(); i++) {
+    dst[i] = (x[i] - y[i]) * z[i] + x[i] / 2.0f;
+  }
+}
+
+void expr_mix(Floats &dst, const Floats &x, const Floats &y,
+              const Floats &z) {
+  using namespace Tiny::Expr;
+  assign(dst, fma(x - y, z, x / 2.0f));
+}
+
+// what the operators would cost if every step made a Vector
+void eager_mix(Floats &dst, const Floats &x, const Floats &y,
+               const Floats &z) {
+  Floats diff(x.size()), prod(x.size()), half(x.size());
+  for (std::size_t i = 0; i < x.size(); i++) {
+    diff[i] = x[i] - y[i];
+  }
+  for (std::size_t i = 0; i < x.size(); i++) {
+    prod[i] = diff[i] * z[i];
+  }
+  for (std::size_t i = 0; i < x.size(); i++) {
+    half[i] = x[i] / 2.0f;
+  }
+  for (std::size_t i = 0; i < x.size(); i++) {
+    dst[i] = prod[i] + half[i];
+  }
+}
+
+float loop_dot(const Floats &x, const Floats &y) {
+  float result = 0;
+  for (std::size_t i = 0; i < x.size(); i++) {
+    result += x[i] * y[i];
+  }
+  return result;
+}
+} // namespace
+
+int main() {
+  const std::size_t size = 1 << 16;
+  std::cout << "Tiny::Expr vs hand-written loops, " << size << " floats"
+            << std::endl;
+
+  Floats x(size), y(size), z(size), dst(size);
+  for (std::size_t i = 0; i < size; i++) {
+    x[i] = static_cast<float>(i % 97) * 0.5f;
+    y[i] = static_cast<float>(i % 89) * 0.25f;
+    z[i] = static_cast<float>(i % 13);
+  }
+  const double n = static_cast<double>(size);
+  const int reps = 50;
+
+  using namespace Tiny;
+  auto run = [&](auto &&f) {
+    return Bench::best_ns([&] {
+             for (int r = 0; r < reps; r++) {
+               f();
+               Bench::keep(dst);
+             }
+           }) /
+           reps;
+  };
+  Bench::report("a*x+y       loop",
+                run([&] { loop_axpy(dst, x, y, 3.0f); }), n);
+  Bench::report("a*x+y       Expr",
+                run([&] { expr_axpy(dst, x, y, 3.0f); }), n);
+  Bench::report("fma(x-y,z,x/2) loop",
+                run([&] { loop_mix(dst, x, y, z); }), n);
+  Bench::report("fma(x-y,z,x/2) Expr",
+                run([&] { expr_mix(dst, x, y, z); }), n);
+  Bench::report("fma(x-y,z,x/2) eager",
+                run([&] { eager_mix(dst, x, y, z); }), n);
+  Bench::report("dot         loop",
+                run([&] { Bench::keep(loop_dot(x, y)); }), n);
+  Bench::report("dot         Expr",
+                run([&] { Bench::keep(Expr::dot(x, y)); }), n);
+  return 0;
+}
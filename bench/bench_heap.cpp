@@ -0,0 +1,74 @@
+#include "Bench.hpp"
+#include "Queue.hpp"
+#include "Vector.hpp"
+#include <functional>
+#include <queue>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+// push every key, then pop them all
+template <typename Q> void push_pop_all(const Tiny::Vector<long> &keys) {
+  Q queue;
+  for (long key : keys) {
+    queue.push(key);
+  }
+  long sum = 0;
+  while (!queue.empty()) {
+    sum += queue.top();
+    queue.pop();
+  }
+  Tiny::Bench::keep(sum);
+}
+
+template <std::size_t Arity> using Heap =
+    Tiny::Priority_Queue<long, std::less<long>, Arity>;
+using StdHeap =
+    std::priority_queue<long, std::vector<long>, std::greater<long>>;
+} // namespace
+
+int main() {
+  std::mt19937_64 rng(42);
+  std::cout << "Tiny::Priority_Queue by arity vs std::priority_queue"
+            << std::endl;
+
+  using namespace Tiny;
+  for (long n : {1L << 10, 1L << 16, 1L << 21}) {
+    Vector<long> keys;
+    for (long i = 0; i < n; i++) {
+      keys.push_back(static_cast<long>(rng() >> 1));
+    }
+    const std::string suffix = " n=" + std::to_string(n);
+    const double ops = 2.0 * n;
+    Bench::report("push+pop std::priority_queue" + suffix,
+                  Bench::best_ns([&] { push_pop_all<StdHeap>(keys); }), ops,
+                  "op");
+    Bench::report("push+pop Priority_Queue<2>" + suffix,
+                  Bench::best_ns([&] { push_pop_all<Heap<2>>(keys); }), ops,
+                  "op");
+    Bench::report("push+pop Priority_Queue<4>" + suffix,
+                  Bench::best_ns([&] { push_pop_all<Heap<4>>(keys); }), ops,
+                  "op");
+    Bench::report("push+pop Priority_Queue<8>" + suffix,
+                  Bench::best_ns([&] { push_pop_all<Heap<8>>(keys); }), ops,
+                  "op");
+
+    Bench::report("build by push Priority_Queue<4>" + suffix,
+                  Bench::best_ns([&] {
+                    Heap<4> heap;
+                    for (long key : keys) {
+                      heap.push(key);
+                    }
+                    Bench::keep(heap.top());
+                  }),
+                  n);
+    Bench::report("build from Vector Priority_Queue<4>" + suffix,
+                  Bench::best_ns([&] {
+                    Heap<4> heap(keys);
+                    Bench::keep(heap.top());
+                  }),
+                  n);
+  }
+  return 0;
+}
@@ -0,0 +1,102 @@
+#include "Bench.hpp"
+#include "Matrix.hpp"
+
+namespace {
+// the hand flattened triple loop Matrix replaces
+void naive_matmul(const float *a, const float *b, float *c, std::size_t n) {
+  for (std::size_t i = 0; i < n; i++) {
+    for (std::size_t j = 0; j < n; j++) {
+      float sum = 0;
+      for (std::size_t p = 0; p < n; p++) {
+        sum += a[i * n + p] * b[p * n + j];
+      }
+      c[i * n + j] = sum;
+    }
+  }
+}
+
+void naive_transpose(const float *src, float *dst, std::size_t n) {
+  for (std::size_t i = 0; i < n; i++) {
+    for (std::size_t j = 0; j < n; j++) {
+      dst[j * n + i] = src[i * n + j];
+    }
+  }
+}
+
+template <std::size_t N> void bench_fixed() {
+  using Mat = Tiny::Matrix<float, N, N>;
+  static Mat a, b, c;
+  for (std::size_t i = 0; i < a.size(); i++) {
+    a.data()[i] = static_cast<float>(i % 7) * 0.5f;
+    b.data()[i] = static_cast<float>(i % 5) * 0.25f;
+  }
+  const double flops = 2.0 * N * N * N;
+  const std::string size = std::to_string(N) + "x" + std::to_string(N);
+
+  using namespace Tiny;
+  Bench::report_rate("matmul naive     Matrix " + size,
+                     Bench::best_ns([&] {
+                       naive_matmul(a.data(), b.data(), c.data(), N);
+                       Bench::keep(c);
+                     }),
+                     flops, "GFLOP/s");
+  Bench::report_rate("matmul blocked   Matrix " + size,
+                     Bench::best_ns([&] {
+                       c = matmul(a, b);
+                       Bench::keep(c);
+                     }),
+                     flops, "GFLOP/s");
+}
+
+void bench_dynamic(std::size_t n) {
+  Tiny::DynMatrix<float> a(n, n), b(n, n), c(n, n);
+  Tiny::Vector<float> x(n, 1.0f);
+  for (std::size_t i = 0; i < a.size(); i++) {
+    a.data()[i] = static_cast<float>(i % 7) * 0.5f;
+    b.data()[i] = static_cast<float>(i % 5) * 0.25f;
+  }
+  const double flops = 2.0 * n * n * n;
+  const std::string size = std::to_string(n) + "x" + std::to_string(n);
+
+  using namespace Tiny;
+  Bench::report_rate("matmul naive     DynMatrix " + size,
+                     Bench::best_ns(
+                         [&] {
+                           naive_matmul(a.data(), b.data(), c.data(), n);
+                           Bench::keep(c);
+                         },
+                         3),
+                     flops, "GFLOP/s");
+  Bench::report_rate("matmul blocked   DynMatrix " + size,
+                     Bench::best_ns([&] {
+                       c = matmul(a, b);
+                       Bench::keep(c);
+                     }),
+                     flops, "GFLOP/s");
+  Bench::report_rate("matvec           DynMatrix " + size,
+                     Bench::best_ns([&] { Bench::keep(matvec(a, x)); }),
+                     2.0 * n * n, "GFLOP/s");
+  Bench::report("transpose naive  DynMatrix " + size,
+                Bench::best_ns([&] {
+                  naive_transpose(a.data(), c.data(), n);
+                  Bench::keep(c);
+                }),
+                static_cast<double>(n * n));
+  Bench::report("transpose tiled  DynMatrix " + size,
+                Bench::best_ns([&] {
+                  c = transpose(a);
+                  Bench::keep(c);
+                }),
+                static_cast<double>(n * n));
+}
+} // namespace
+
+int main() {
+  std::cout << "Tiny::Matrix kernels vs naive loops, float" << std::endl;
+  bench_fixed<64>();
+  bench_fixed<128>();
+  bench_dynamic(256);
+  bench_dynamic(512);
+  bench_dynamic(1024);
+  return 0;
+}
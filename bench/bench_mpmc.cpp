@@ -0,0 +1,135 @@
+#include "Bench.hpp"
+#include "ConcurrentQueue.hpp"
+#include "Queue.hpp"
+#include "Thread.hpp"
+#include "Vector.hpp"
+#include <span>
+#include <string>
+#include <unistd.h>
+
+namespace {
+// the mutex-wrapped Queue the worker pools use today, bounded like the
+// MPMCQueue; on a Deque since forwardList::push_back walks the whole list
+using LockedQueue =
+    Tiny::Bench::Locked<long, Tiny::Queue<long, Tiny::Deque<long>>>;
+
+template <typename F> void run(int threads, F &&body) {
+  Tiny::Vector<Tiny::Thread> pool;
+  for (int t = 0; t < threads; t++) {
+    pool.push_back(Tiny::Thread(body, t));
+  }
+  for (Tiny::Thread &thread : pool) {
+    thread.join();
+  }
+}
+
+// every thread pushes a burst of 4 and pops 4 back, ops pairs in total
+template <typename Q> void burst(Q &queue, int threads, long ops) {
+  run(threads, [&queue, ops = ops / threads](int) {
+    long sum = 0;
+    long value;
+    for (long i = 0; i < ops; i += 4) {
+      for (long k = 0; k < 4; k++) {
+        queue.try_push(i + k);
+      }
+      for (long k = 0; k < 4; k++) {
+        sum += queue.try_pop(value) ? value : 0;
+      }
+    }
+    Tiny::Bench::keep(sum);
+  });
+}
+
+// the same with one try_push_n and one try_pop_n per burst
+void burst_bulk(Tiny::MPMCQueue<long> &queue, int threads, long ops) {
+  run(threads, [&queue, ops = ops / threads](int) {
+    long sum = 0;
+    long values[4];
+    for (long i = 0; i < ops; i += 4) {
+      for (long k = 0; k < 4; k++) {
+        values[k] = i + k;
+      }
+      queue.try_push_n(values);
+      const std::size_t popped = queue.try_pop_n(values);
+      for (std::size_t k = 0; k < popped; k++) {
+        sum += values[k];
+      }
+    }
+    Tiny::Bench::keep(sum);
+  });
+}
+
+// half the threads only push and half only pop, with the blocking calls
+template <typename Q> void fan(Q &queue, int threads, long ops) {
+  const int producers = threads / 2;
+  const long each = ops / producers;
+  run(threads, [&queue, producers, each](int t) {
+    long sum = 0;
+    for (long i = 0; i < each; i++) {
+      if (t < producers) {
+        queue.push(i);
+      } else {
+        sum += queue.pop();
+      }
+    }
+    Tiny::Bench::keep(sum);
+  });
+}
+} // namespace
+
+int main() {
+  const long ops = 1 << 20;
+  const std::size_t capacity = 1024;
+  std::cout << "Tiny::MPMCQueue vs mutex + Tiny::Queue, " << ops
+            << " messages shared by all threads, "
+            << sysconf(_SC_NPROCESSORS_ONLN) << " cpus online" << std::endl;
+
+  using namespace Tiny;
+  for (int threads : {1, 2, 4, 8, 16, 32, 64}) {
+    const std::string suffix = " x" + std::to_string(threads);
+    Bench::report("burst mutex Queue" + suffix,
+                  Bench::best_ns(
+                      [&] {
+                        LockedQueue queue(capacity);
+                        burst(queue, threads, ops);
+                      },
+                      3),
+                  ops, "pair");
+    Bench::report("burst MPMCQueue" + suffix,
+                  Bench::best_ns(
+                      [&] {
+                        MPMCQueue<long> queue(capacity);
+                        burst(queue, threads, ops);
+                      },
+                      3),
+                  ops, "pair");
+    Bench::report("burst MPMCQueue bulk" + suffix,
+                  Bench::best_ns(
+                      [&] {
+                        MPMCQueue<long> queue(capacity);
+                        burst_bulk(queue, threads, ops);
+                      },
+                      3),
+                  ops, "pair");
+    if (threads == 1) {
+      continue;
+    }
+    Bench::report("fan mutex Queue" + suffix,
+                  Bench::best_ns(
+                      [&] {
+                        LockedQueue queue(capacity);
+                        fan(queue, threads, ops);
+                      },
+                      3),
+                  ops, "msg");
+    Bench::report("fan MPMCQueue" + suffix,
+                  Bench::best_ns(
+                      [&] {
+                        MPMCQueue<long> queue(capacity);
+                        fan(queue, threads, ops);
+                      },
+                      3),
+                  ops, "msg");
+  }
+  return 0;
+}
@@ -0,0 +1,107 @@
+#include "Bench.hpp"
+#include "Simd.hpp"
+#include "Vector.hpp"
+#include <cstdint>
+#include <random>
+
+namespace {
+// the loops the kernels replace, going through operator[] on the Vector
+template <typename T>
+std::size_t loop_count(const Tiny::Vector<T> &vec, const T &value) {
+  std::size_t result = 0;
+  for (std::size_t i = 0; i < vec.size(); i++) {
+    result += vec[i] == value;
+  }
+  return result;
+}
+
+template <typename T>
+std::size_t loop_find(const Tiny::Vector<T> &vec, const T &value) {
+  for (std::size_t i = 0; i < vec.size(); i++) {
+    if (vec[i] == value) {
+      return i;
+    }
+  }
+  return vec.size();
+}
+
+template <typename T> T loop_sum(const Tiny::Vector<T> &vec) {
+  T result = T();
+  for (std::size_t i = 0; i < vec.size(); i++) {
+    result += vec[i];
+  }
+  return result;
+}
+
+template <typename T> T loop_min(const Tiny::Vector<T> &vec) {
+  T result = vec[0];
+  for (std::size_t i = 1; i < vec.size(); i++) {
+    if (vec[i] < result) {
+      result = vec[i];
+    }
+  }
+  return result;
+}
+
+template <typename T> T loop_max(const Tiny::Vector<T> &vec) {
+  T result = vec[0];
+  for (std::size_t i = 1; i < vec.size(); i++) {
+    if (result < vec[i]) {
+      result = vec[i];
+    }
+  }
+  return result;
+}
+
+template <typename T> void run(const std::string &type, std::size_t size) {
+  std::mt19937 rng(42);
+  Tiny::Vector<T> vec;
+  vec.reserve(size);
+  for (std::size_t i = 0; i < size; i++) {
+    vec.push_back(static_cast<T>(rng() % 100));
+  }
+  // a value that is never present, so find scans everything
+  const T missing = static_cast<T>(101);
+  const double n = static_cast<double>(size);
+
+  using namespace Tiny;
+  Bench::report(type + " count  loop",
+                Bench::best_ns([&] { Bench::keep(loop_count(vec, missing)); }),
+                n);
+  Bench::report(type + " count  simd",
+                Bench::best_ns([&] { Bench::keep(Simd::count(vec, missing)); }),
+                n);
+  Bench::report(type + " find   loop",
+                Bench::best_ns([&] { Bench::keep(loop_find(vec, missing)); }),
+                n);
+  Bench::report(type + " find   simd",
+                Bench::best_ns([&] { Bench::keep(Simd::find(vec, missing)); }),
+                n);
+  Bench::report(type + " sum    loop",
+                Bench::best_ns([&] { Bench::keep(loop_sum(vec)); }), n);
+  Bench::report(type + " sum    simd",
+                Bench::best_ns([&] { Bench::keep(Simd::sum(vec)); }), n);
+  Bench::report(type + " min    loop",
+                Bench::best_ns([&] { Bench::keep(loop_min(vec)); }), n);
+  Bench::report(type + " min    simd",
+                Bench::best_ns([&] { Bench::keep(Simd::min(vec)); }), n);
+  Bench::report(type + " max    loop",
+                Bench::best_ns([&] { Bench::keep(loop_max(vec)); }), n);
+  Bench::report(type + " max    simd",
+                Bench::best_ns([&] { Bench::keep(Simd::max(vec)); }), n);
+  Bench::report(type + " minmax simd",
+                Bench::best_ns([&] { Bench::keep(Simd::minmax(vec)); }), n);
+}
+} // namespace
+
+int main() {
+  const std::size_t size = 1 << 22;
+  std::cout << "Tiny::Simd kernels vs operator[] loops, " << size
+            << " elements" << std::endl;
+  run<std::int32_t>("int32", size);
+  run<std::int64_t>("int64", size);
+  run<float>("float", size);
+  run<double>("double", size);
+  run<std::uint8_t>("uint8", size);
+  return 0;
+}
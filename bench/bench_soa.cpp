@@ -0,0 +1,107 @@
+#include "Bench.hpp"
+#include "SoAVector.hpp"
+#include "Vector.hpp"
+#include <cstdint>
+#include <random>
+
+namespace {
+// a typical 64 byte record where hot loops only read one or two fields
+struct Record {
+  double price;
+  float weight;
+  std::int32_t id;
+  std::int64_t timestamp;
+  double extra[5];
+};
+
+using Table = Tiny::SoAVector<double, float, std::int32_t, std::int64_t>;
+
+double aos_sum(const Tiny::Vector<Record> &vec) {
+  double result = 0;
+  for (std::size_t i = 0; i < vec.size(); i++) {
+    result += vec[i].price;
+  }
+  return result;
+}
+
+double soa_sum(const Table &table) {
+  double result = 0;
+  for (double price : table.column<0>()) {
+    result += price;
+  }
+  return result;
+}
+
+double aos_dot(const Tiny::Vector<Record> &vec) {
+  double result = 0;
+  for (std::size_t i = 0; i < vec.size(); i++) {
+    result += vec[i].price * vec[i].weight;
+  }
+  return result;
+}
+
+double soa_dot(const Table &table) {
+  const double *price = table.data<0>();
+  const float *weight = table.data<1>();
+  double result = 0;
+  for (std::size_t i = 0; i < table.size(); i++) {
+    result += price[i] * weight[i];
+  }
+  return result;
+}
+
+std::size_t aos_count(const Tiny::Vector<Record> &vec, std::int32_t id) {
+  std::size_t result = 0;
+  for (std::size_t i = 0; i < vec.size(); i++) {
+    result += vec[i].id == id;
+  }
+  return result;
+}
+
+std::size_t soa_count(const Table &table, std::int32_t id) {
+  std::size_t result = 0;
+  for (std::int32_t value : table.column<2>()) {
+    result += value == id;
+  }
+  return result;
+}
+} // namespace
+
+int main() {
+  const std::size_t size = 1 << 21;
+  std::cout << "Tiny::SoAVector columns vs Tiny::Vector<Record>, " << size
+            << " rows of " << sizeof(Record) << " bytes" << std::endl;
+
+  std::mt19937 rng(42);
+  Tiny::Vector<Record> records;
+  Table table;
+  records.reserve(size);
+  table.reserve(size);
+  for (std::size_t i = 0; i < size; i++) {
+    Record record{};
+    record.price = rng() % 1000 * 0.01;
+    record.weight = static_cast<float>(rng() % 100);
+    record.id = static_cast<std::int32_t>(rng() % 1000);
+    record.timestamp = static_cast<std::int64_t>(i);
+    records.push_back(record);
+    table.emplace_back(record.price, record.weight, record.id,
+                       record.timestamp);
+  }
+  const double n = static_cast<double>(size);
+
+  using namespace Tiny;
+  Bench::report("sum price    Vector<Record>",
+                Bench::best_ns([&] { Bench::keep(aos_sum(records)); }), n);
+  Bench::report("sum price    SoAVector",
+                Bench::best_ns([&] { Bench::keep(soa_sum(table)); }), n);
+  Bench::report("price*weight Vector<Record>",
+                Bench::best_ns([&] { Bench::keep(aos_dot(records)); }), n);
+  Bench::report("price*weight SoAVector",
+                Bench::best_ns([&] { Bench::keep(soa_dot(table)); }), n);
+  Bench::report("count id     Vector<Record>",
+                Bench::best_ns([&] { Bench::keep(aos_count(records, 7)); }),
+                n);
+  Bench::report("count id     SoAVector",
+                Bench::best_ns([&] { Bench::keep(soa_count(table, 7)); }), n);
+  return 0;
+}
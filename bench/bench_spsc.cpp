@@ -0,0 +1,171 @@
+#include "Bench.hpp"
+#include "ConcurrentQueue.hpp"
+#include "Queue.hpp"
+#include "Thread.hpp"
+#include <algorithm>
+#include <pthread.h>
+#include <sched.h>
+#include <span>
+#include <string>
+#include <unistd.h>
+
+namespace {
+// the mutex-guarded Queue a pipeline stage would otherwise use, bounded like
+// the SPSCQueue so both sides can stall; on a Deque since
+// forwardList::push_back walks the whole list
+using LockedQueue =
+    Tiny::Bench::Locked<long, Tiny::Queue<long, Tiny::Deque<long>>>;
+
+// pin the calling thread to cpu when there is more than one to choose from,
+// on a single cpu both threads share it and take turns
+void pin(int cpu) {
+  const long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+  if (cpus < 2) {
+    return;
+  }
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  CPU_SET(cpu % cpus, &set);
+  pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+}
+
+// spin a little, then give the cpu away
+struct Backoff {
+  void wait() {
+    if (++spins_ > 64) {
+      sched_yield();
+    }
+  }
+  void reset() { spins_ = 0; }
+
+  int spins_ = 0;
+};
+
+template <typename Q> void push(Q &queue, long value) {
+  Backoff backoff;
+  while (!queue.try_push(value)) {
+    backoff.wait();
+  }
+}
+
+template <typename Q> long pop(Q &queue) {
+  Backoff backoff;
+  long value;
+  while (!queue.try_pop(value)) {
+    backoff.wait();
+  }
+  return value;
+}
+
+// one thread pushes count values, this one pops them
+template <typename Q> void stream(Q &queue, long count) {
+  Tiny::Thread producer([&queue, count] {
+    pin(1);
+    for (long i = 0; i < count; i++) {
+      push(queue, i);
+    }
+  });
+  pin(0);
+  long sum = 0;
+  for (long i = 0; i < count; i++) {
+    sum += pop(queue);
+  }
+  producer.join();
+  Tiny::Bench::keep(sum);
+}
+
+// the same, moving batch values per call
+void stream_batched(Tiny::SPSCQueue<long> &queue, long count, long batch) {
+  Tiny::Thread producer([&queue, count, batch] {
+    pin(1);
+    long values[256];
+    Backoff backoff;
+    for (long i = 0; i < count;) {
+      const long n = std::min(batch, count - i);
+      for (long k = 0; k < n; k++) {
+        values[k] = i + k;
+      }
+      std::span<long> pending(values, n);
+      while (!pending.empty()) {
+        const std::size_t pushed = queue.try_push_n(pending);
+        pending = pending.subspan(pushed);
+        pushed == 0 ? backoff.wait() : backoff.reset();
+      }
+      i += n;
+    }
+  });
+  pin(0);
+  long values[256];
+  long sum = 0;
+  Backoff backoff;
+  for (long i = 0; i < count;) {
+    const std::size_t popped =
+        queue.try_pop_n(std::span<long>(values, batch));
+    for (std::size_t k = 0; k < popped; k++) {
+      sum += values[k];
+    }
+    popped == 0 ? backoff.wait() : backoff.reset();
+    i += popped;
+  }
+  producer.join();
+  Tiny::Bench::keep(sum);
+}
+
+// a message goes out on one queue and comes back on the other, the time
+// per trip is the handoff latency in both directions
+template <typename Q> void ping_pong(Q &there, Q &back, long trips) {
+  Tiny::Thread echo([&there, &back, trips] {
+    pin(1);
+    for (long i = 0; i < trips; i++) {
+      push(back, pop(there));
+    }
+  });
+  pin(0);
+  for (long i = 0; i < trips; i++) {
+    push(there, i);
+    Tiny::Bench::keep(pop(back));
+  }
+  echo.join();
+}
+} // namespace
+
+int main() {
+  const long count = 1 << 22;
+  const long trips = 1 << 16;
+  const std::size_t capacity = 1024;
+  std::cout << "Tiny::SPSCQueue vs mutex + Tiny::Queue, " << count
+            << " messages through a " << capacity << " slot queue, "
+            << sysconf(_SC_NPROCESSORS_ONLN) << " cpus online" << std::endl;
+
+  using namespace Tiny;
+  Bench::report_rate("throughput mutex Queue", Bench::best_ns([&] {
+                       LockedQueue queue(capacity);
+                       stream(queue, count);
+                     }),
+                     count * 1e3, "Mmsg/s");
+  Bench::report_rate("throughput SPSCQueue", Bench::best_ns([&] {
+                       SPSCQueue<long> queue(capacity);
+                       stream(queue, count);
+                     }),
+                     count * 1e3, "Mmsg/s");
+  for (long batch : {16L, 256L}) {
+    Bench::report_rate("throughput SPSCQueue batch " + std::to_string(batch),
+                       Bench::best_ns([&] {
+                         SPSCQueue<long> queue(capacity);
+                         stream_batched(queue, count, batch);
+                       }),
+                       count * 1e3, "Mmsg/s");
+  }
+
+  Bench::report("round trip mutex Queue", Bench::best_ns([&] {
+                  LockedQueue there(capacity), back(capacity);
+                  ping_pong(there, back, trips);
+                }),
+                trips, "trip");
+  Bench::report("round trip SPSCQueue", Bench::best_ns([&] {
+                  SPSCQueue<long> there(capacity), back(capacity);
+                  ping_pong(there, back, trips);
+                }),
+                trips, "trip");
+  return 0;
+}
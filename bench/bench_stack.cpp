@@ -0,0 +1,62 @@
+#include "Bench.hpp"
+#include "ConcurrentStack.hpp"
+#include "Stack.hpp"
+#include "Thread.hpp"
+#include "Vector.hpp"
+#include <string>
+
+namespace {
+// the mutex-guarded Stack ConcurrentStack replaces
+using LockedStack = Tiny::Bench::Locked<long, Tiny::Stack<long>>;
+
+// every thread pushes and pops ops times, bursts of 4 pushes then 4 pops
+template <typename S> void hammer(S &stack, int threads, long ops) {
+  Tiny::Vector<Tiny::Thread> pool;
+  for (int t = 0; t < threads; t++) {
+    pool.push_back(Tiny::Thread([&stack, ops] {
+      long sum = 0;
+      for (long i = 0; i < ops; i += 4) {
+        for (long k = 0; k < 4; k++) {
+          stack.push(i + k);
+        }
+        for (long k = 0; k < 4; k++) {
+          sum += stack.try_pop().value_or(0);
+        }
+      }
+      Tiny::Bench::keep(sum);
+    }));
+  }
+  for (Tiny::Thread &thread : pool) {
+    thread.join();
+  }
+}
+} // namespace
+
+int main() {
+  const long ops = 1 << 18;
+  std::cout << "Tiny::ConcurrentStack vs mutex + Tiny::Stack, " << ops
+            << " push/pop pairs per thread" << std::endl;
+
+  using namespace Tiny;
+  for (int threads : {1, 2, 4, 8, 16}) {
+    const double pairs = static_cast<double>(ops) * threads;
+    const std::string suffix = " x" + std::to_string(threads);
+    Bench::report("mutex Stack" + suffix,
+                  Bench::best_ns(
+                      [&] {
+                        LockedStack stack;
+                        hammer(stack, threads, ops);
+                      },
+                      3),
+                  pairs, "pair");
+    Bench::report("ConcurrentStack" + suffix,
+                  Bench::best_ns(
+                      [&] {
+                        ConcurrentStack<long> stack;
+                        hammer(stack, threads, ops);
+                      },
+                      3),
+                  pairs, "pair");
+  }
+  return 0;
+}
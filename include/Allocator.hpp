@@ -0,0 +1,128 @@
+#ifndef TINY_ALLOCATOR_HPP
+#define TINY_ALLOCATOR_HPP
+
+#include <concepts>
+#include <cstddef>
+#include <new>
+#include <numeric>
+
+namespace Tiny {
+// allocators that can grow or shrink a block while keeping its bytes,
+// e.g. by remapping pages instead of copying them
+// containers only use it for elements that may be relocated bitwise
+template <typename Alloc>
+concept ReallocatingAllocator =
+    requires(Alloc &alloc, typename Alloc::value_type *ptr, std::size_t n) {
+      {
+        alloc.reallocate(ptr, n, n)
+      } -> std::same_as<typename Alloc::value_type *>;
+    };
+
+// allocators that want container capacities rounded up, e.g. to whole
+// SIMD registers, so a kernel never has to peel a remainder loop
+template <typename Alloc>
+concept CapacityRoundingAllocator =
+    requires(const Alloc &alloc, std::size_t n) {
+      { alloc.round_capacity(n) } -> std::same_as<std::size_t>;
+    };
+
+// stateless default allocator, hands out raw storage from operator new
+template <typename T> class Allocator {
+public:
+  using value_type = T;
+
+  Allocator() noexcept = default;
+  template <typename U> Allocator(const Allocator<U> &) noexcept {}
+
+  T *allocate(std::size_t n);
+  void deallocate(T *ptr, std::size_t n) noexcept;
+
+  template <typename U>
+  friend bool operator==(const Allocator &, const Allocator<U> &) noexcept {
+    return true;
+  }
+};
+
+// allocator whose blocks start on an Align byte boundary, e.g. 32 for AVX2
+// or 64 for AVX-512 and cache lines
+// with PadCapacity every block also spans a whole number of Align chunks
+template <typename T, std::size_t Align = 64, bool PadCapacity = true>
+class AlignedAllocator {
+  static_assert((Align & (Align - 1)) == 0,
+                "Alignment must be a power of two.");
+  static_assert(Align >= alignof(T),
+                "Alignment must not be weaker than alignof(T).");
+
+public:
+  using value_type = T;
+  static constexpr std::size_t alignment = Align;
+
+  template <typename U> struct rebind {
+    using other = AlignedAllocator<U, Align, PadCapacity>;
+  };
+
+  AlignedAllocator() noexcept = default;
+  template <typename U>
+  AlignedAllocator(const AlignedAllocator<U, Align, PadCapacity> &) noexcept {}
+
+  T *allocate(std::size_t n);
+  void deallocate(T *ptr, std::size_t n) noexcept;
+  std::size_t round_capacity(std::size_t n) const
+    requires PadCapacity;
+
+  template <typename U>
+  friend bool
+  operator==(const AlignedAllocator &,
+             const AlignedAllocator<U, Align, PadCapacity> &) noexcept {
+    return true;
+  }
+};
+} // namespace Tiny
+
+template <typename T> T *Tiny::Allocator<T>::allocate(std::size_t n) {
+  if (n > static_cast<std::size_t>(-1) / sizeof(T)) {
+    throw std::bad_array_new_length();
+  }
+  if constexpr (alignof(T) > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+    return static_cast<T *>(
+        ::operator new(n * sizeof(T), std::align_val_t(alignof(T))));
+  } else {
+    return static_cast<T *>(::operator new(n * sizeof(T)));
+  }
+}
+
+template <typename T>
+void Tiny::Allocator<T>::deallocate(T *ptr, std::size_t n) noexcept {
+  if constexpr (alignof(T) > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+    ::operator delete(ptr, n * sizeof(T), std::align_val_t(alignof(T)));
+  } else {
+    ::operator delete(ptr, n * sizeof(T));
+  }
+}
+
+template <typename T, std::size_t Align, bool PadCapacity>
+T *Tiny::AlignedAllocator<T, Align, PadCapacity>::allocate(std::size_t n) {
+  if (n > static_cast<std::size_t>(-1) / sizeof(T)) {
+    throw std::bad_array_new_length();
+  }
+  return static_cast<T *>(
+      ::operator new(n * sizeof(T), std::align_val_t(Align)));
+}
+
+template <typename T, std::size_t Align, bool PadCapacity>
+void Tiny::AlignedAllocator<T, Align, PadCapacity>::deallocate(
+    T *ptr, std::size_t n) noexcept {
+  ::operator delete(ptr, n * sizeof(T), std::align_val_t(Align));
+}
+
+// smallest element count >= n whose byte size is a multiple of Align
+template <typename T, std::size_t Align, bool PadCapacity>
+std::size_t Tiny::AlignedAllocator<T, Align, PadCapacity>::round_capacity(
+    std::size_t n) const
+  requires PadCapacity
+{
+  constexpr std::size_t step = Align / std::gcd(Align, sizeof(T));
+  return (n + step - 1) / step * step;
+}
+
+#endif // TINY_ALLOCATOR_HPP
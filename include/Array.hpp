@@ -1,82 +1,136 @@
 #ifndef TINY_ARRAY_HPP
 #define TINY_ARRAY_HPP
 
+#include <algorithm>
 #include <cstddef>
+#include <functional>
 #include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
 
 namespace Tiny {
+// fixed size array, an aggregate so it can be brace initialized and built
+// entirely at compile time, e.g.
+//   constexpr auto table = [] {
+//     Tiny::Array<std::uint8_t, 256> t{};
+//     t.generate([](std::size_t i) { return reverse_bits(i); });
+//     return t;
+//   }();
 template <typename T, std::size_t N> class Array {
   static_assert(N > 0, "Array size must be greater than 0.");
 
-private:
+public:
+  using iterator = T *;
+  using const_iterator = const T *;
+
+  // public only so that Array stays an aggregate, use data() instead
   T m_data[N];
 
-public:
-  Array() = default;
-  Array(const Array &other) = default;
-  Array(Array &&other) = default;
-  Array &operator=(const Array &other) = default;
-  Array &operator=(Array &&other) = default;
-  ~Array() = default;
+  constexpr T &operator[](std::size_t index);
+  constexpr const T &operator[](std::size_t index) const;
 
-  T &operator[](std::size_t index);
-  const T &operator[](std::size_t index) const;
+  constexpr T *data();
+  constexpr const T *data() const;
 
-  T *data();
-  const T *data() const;
+  constexpr std::size_t size() const;
 
-  std::size_t size() const;
+  constexpr void fill(const T &value);
 
-  void fill(const T &value);
+  constexpr T front() const;
+  constexpr T back() const;
 
-  T front() const;
-  T back() const;
+  constexpr T &at(std::size_t index);
+  constexpr const T &at(std::size_t index) const;
 
-  T &at(std::size_t index);
-  const T &at(std::size_t index) const;
+  // Iterators
+  constexpr iterator begin();
+  constexpr const_iterator begin() const;
+  constexpr iterator end();
+  constexpr const_iterator end() const;
+
+  // Algorithms
+  template <typename Compare = std::less<>>
+  constexpr void sort(Compare comp = Compare());
+  constexpr std::size_t find(const T &value) const;
+  constexpr void iota(T value);
+  template <typename F> constexpr void generate(F f);
 };
+
+// Array{1, 2, 3} is an Array<int, 3>
+template <typename T, typename... U>
+Array(T, U...) -> Array<T, 1 + sizeof...(U)>;
+
+template <typename T, std::size_t N>
+constexpr bool operator==(const Array<T, N> &lhs, const Array<T, N> &rhs);
+
+template <typename T, std::size_t N>
+constexpr Array<std::remove_cv_t<T>, N> to_array(T (&arr)[N]);
+template <typename T, std::size_t N>
+constexpr Array<std::remove_cv_t<T>, N> to_array(T (&&arr)[N]);
+
+// tuple protocol, for structured bindings
+template <std::size_t I, typename T, std::size_t N>
+constexpr T &get(Array<T, N> &arr);
+template <std::size_t I, typename T, std::size_t N>
+constexpr const T &get(const Array<T, N> &arr);
+template <std::size_t I, typename T, std::size_t N>
+constexpr T &&get(Array<T, N> &&arr);
 } // namespace Tiny
 
 template <typename T, std::size_t N>
-T &Tiny::Array<T, N>::operator[](std::size_t index) {
+struct std::tuple_size<Tiny::Array<T, N>>
+    : std::integral_constant<std::size_t, N> {};
+
+template <std::size_t I, typename T, std::size_t N>
+struct std::tuple_element<I, Tiny::Array<T, N>> {
+  static_assert(I < N, "Array index out of range.");
+  using type = T;
+};
+
+template <typename T, std::size_t N>
+constexpr T &Tiny::Array<T, N>::operator[](std::size_t index) {
   return m_data[index];
 }
 
 template <typename T, std::size_t N>
-const T &Tiny::Array<T, N>::operator[](std::size_t index) const {
+constexpr const T &Tiny::Array<T, N>::operator[](std::size_t index) const {
   return m_data[index];
 }
 
-template <typename T, std::size_t N> T *Tiny::Array<T, N>::data() {
+template <typename T, std::size_t N> constexpr T *Tiny::Array<T, N>::data() {
   return m_data;
 }
 
-template <typename T, std::size_t N> const T *Tiny::Array<T, N>::data() const {
+template <typename T, std::size_t N>
+constexpr const T *Tiny::Array<T, N>::data() const {
   return m_data;
 }
 
 template <typename T, std::size_t N>
-std::size_t Tiny::Array<T, N>::size() const {
+constexpr std::size_t Tiny::Array<T, N>::size() const {
   return N;
 }
 
 template <typename T, std::size_t N>
-void Tiny::Array<T, N>::fill(const T &value) {
+constexpr void Tiny::Array<T, N>::fill(const T &value) {
   for (std::size_t i = 0; i < N; i++) {
     m_data[i] = value;
   }
 }
 
-template <typename T, std::size_t N> T Tiny::Array<T, N>::front() const {
+template <typename T, std::size_t N>
+constexpr T Tiny::Array<T, N>::front() const {
   return m_data[0];
 }
 
-template <typename T, std::size_t N> T Tiny::Array<T, N>::back() const {
+template <typename T, std::size_t N>
+constexpr T Tiny::Array<T, N>::back() const {
   return m_data[N - 1];
 }
 
 template <typename T, std::size_t N>
-T &Tiny::Array<T, N>::at(std::size_t index) {
+constexpr T &Tiny::Array<T, N>::at(std::size_t index) {
   if (index >= N) {
     throw std::out_of_range("Array::at");
   }
@@ -85,7 +139,7 @@ T &Tiny::Array<T, N>::at(std::size_t index) {
 }
 
 template <typename T, std::size_t N>
-const T &Tiny::Array<T, N>::at(std::size_t index) const {
+constexpr const T &Tiny::Array<T, N>::at(std::size_t index) const {
   if (index >= N) {
     throw std::out_of_range("Array::at");
   }
@@ -93,4 +147,106 @@ const T &Tiny::Array<T, N>::at(std::size_t index) const {
   return m_data[index];
 }
 
-#endif // TINY_ARRAY_HPP
\ No newline at end of file
+template <typename T, std::size_t N>
+constexpr typename Tiny::Array<T, N>::iterator Tiny::Array<T, N>::begin() {
+  return m_data;
+}
+
+template <typename T, std::size_t N>
+constexpr typename Tiny::Array<T, N>::const_iterator
+Tiny::Array<T, N>::begin() const {
+  return m_data;
+}
+
+template <typename T, std::size_t N>
+constexpr typename Tiny::Array<T, N>::iterator Tiny::Array<T, N>::end() {
+  return m_data + N;
+}
+
+template <typename T, std::size_t N>
+constexpr typename Tiny::Array<T, N>::const_iterator
+Tiny::Array<T, N>::end() const {
+  return m_data + N;
+}
+
+// sort in place, usable in constant expressions
+template <typename T, std::size_t N>
+template <typename Compare>
+constexpr void Tiny::Array<T, N>::sort(Compare comp) {
+  std::sort(m_data, m_data + N, comp);
+}
+
+// index of the first element equal to value, N if there is none
+template <typename T, std::size_t N>
+constexpr std::size_t Tiny::Array<T, N>::find(const T &value) const {
+  for (std::size_t i = 0; i < N; i++) {
+    if (m_data[i] == value) {
+      return i;
+    }
+  }
+  return N;
+}
+
+// value, value + 1, value + 2, ...
+template <typename T, std::size_t N>
+constexpr void Tiny::Array<T, N>::iota(T value) {
+  for (std::size_t i = 0; i < N; i++, ++value) {
+    m_data[i] = value;
+  }
+}
+
+// element i becomes f(i), the usual way to fill a lookup table
+template <typename T, std::size_t N>
+template <typename F>
+constexpr void Tiny::Array<T, N>::generate(F f) {
+  for (std::size_t i = 0; i < N; i++) {
+    m_data[i] = f(i);
+  }
+}
+
+template <typename T, std::size_t N>
+constexpr bool Tiny::operator==(const Array<T, N> &lhs,
+                                const Array<T, N> &rhs) {
+  for (std::size_t i = 0; i < N; i++) {
+    if (!(lhs[i] == rhs[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// copy a built-in array into an Array
+template <typename T, std::size_t N>
+constexpr Tiny::Array<std::remove_cv_t<T>, N> Tiny::to_array(T (&arr)[N]) {
+  return [&]<std::size_t... I>(std::index_sequence<I...>) {
+    return Array<std::remove_cv_t<T>, N>{{arr[I]...}};
+  }(std::make_index_sequence<N>());
+}
+
+// move a built-in array into an Array
+template <typename T, std::size_t N>
+constexpr Tiny::Array<std::remove_cv_t<T>, N> Tiny::to_array(T (&&arr)[N]) {
+  return [&]<std::size_t... I>(std::index_sequence<I...>) {
+    return Array<std::remove_cv_t<T>, N>{{std::move(arr[I])...}};
+  }(std::make_index_sequence<N>());
+}
+
+template <std::size_t I, typename T, std::size_t N>
+constexpr T &Tiny::get(Array<T, N> &arr) {
+  static_assert(I < N, "Array index out of range.");
+  return arr.m_data[I];
+}
+
+template <std::size_t I, typename T, std::size_t N>
+constexpr const T &Tiny::get(const Array<T, N> &arr) {
+  static_assert(I < N, "Array index out of range.");
+  return arr.m_data[I];
+}
+
+template <std::size_t I, typename T, std::size_t N>
+constexpr T &&Tiny::get(Array<T, N> &&arr) {
+  static_assert(I < N, "Array index out of range.");
+  return std::move(arr.m_data[I]);
+}
+
+#endif // TINY_ARRAY_HPP
@@ -0,0 +1,352 @@
+#ifndef TINY_BIT_VECTOR_HPP
+#define TINY_BIT_VECTOR_HPP
+
+#include "Simd.hpp"
+#include "Vector.hpp"
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+
+namespace Tiny {
+// bits packed into 64 bit words, bit i lives in word i / 64 at i % 64
+// bits past size() in the last word are always zero, so word loops never
+// need a tail mask
+// rank and select can use an index of running counts, one per 512 bits;
+// build it with build_rank_index once the bits stop changing, any write
+// drops it and the queries fall back to scanning
+class BitVector {
+public:
+  using word_type = std::uint64_t;
+  static constexpr std::size_t word_bits = 64;
+
+  BitVector() : size_(0), rank_valid_(false) {}
+
+  explicit BitVector(std::size_t size, bool value = false)
+      : words_(_words_for(size), value ? ~word_type(0) : word_type(0)),
+        size_(size), rank_valid_(false) {
+    _clear_tail();
+  }
+
+  // Bit access
+  bool operator[](std::size_t index) const {
+    return (words_[index / word_bits] >> (index % word_bits)) & 1;
+  }
+
+  bool test(std::size_t index) const {
+    if (index >= size_) {
+      throw std::out_of_range("Index out of range");
+    }
+    return (*this)[index];
+  }
+
+  void set(std::size_t index) {
+    rank_valid_ = false;
+    words_[index / word_bits] |= _bit(index);
+  }
+
+  void set(std::size_t index, bool value) {
+    if (value) {
+      set(index);
+    } else {
+      reset(index);
+    }
+  }
+
+  void reset(std::size_t index) {
+    rank_valid_ = false;
+    words_[index / word_bits] &= ~_bit(index);
+  }
+
+  void flip(std::size_t index) {
+    rank_valid_ = false;
+    words_[index / word_bits] ^= _bit(index);
+  }
+
+  // Capacity
+  std::size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+  std::size_t word_count() const { return words_.size(); }
+
+  // Modifiers
+  void push_back(bool value) {
+    if (size_ % word_bits == 0) {
+      words_.push_back(0);
+    }
+    ++size_;
+    set(size_ - 1, value);
+  }
+
+  void pop_back() {
+    reset(size_ - 1);
+    --size_;
+    if (size_ % word_bits == 0) {
+      words_.pop_back();
+    }
+  }
+
+  // new bits take value
+  void resize(std::size_t size, bool value = false) {
+    rank_valid_ = false;
+    const std::size_t old_size = size_;
+    words_.resize(_words_for(size), value ? ~word_type(0) : word_type(0));
+    size_ = size;
+    if (value && size > old_size && old_size % word_bits != 0) {
+      words_[old_size / word_bits] |= ~word_type(0) << (old_size % word_bits);
+    }
+    _clear_tail();
+  }
+
+  void clear() {
+    words_.clear();
+    rank_.clear();
+    size_ = 0;
+    rank_valid_ = false;
+  }
+
+  void reserve(std::size_t size) { words_.reserve(_words_for(size)); }
+
+  // set, reset or flip every bit
+  void set() {
+    _fill(~word_type(0));
+    _clear_tail();
+  }
+
+  void reset() { _fill(0); }
+
+  void flip() {
+    rank_valid_ = false;
+    for (word_type &word : words_) {
+      word = ~word;
+    }
+    _clear_tail();
+  }
+
+  // Bulk operations, both sides must have the same size
+  BitVector &operator&=(const BitVector &other) {
+    _check_size(other);
+    rank_valid_ = false;
+    for (std::size_t i = 0; i < words_.size(); ++i) {
+      words_[i] &= other.words_[i];
+    }
+    return *this;
+  }
+
+  BitVector &operator|=(const BitVector &other) {
+    _check_size(other);
+    rank_valid_ = false;
+    for (std::size_t i = 0; i < words_.size(); ++i) {
+      words_[i] |= other.words_[i];
+    }
+    return *this;
+  }
+
+  BitVector &operator^=(const BitVector &other) {
+    _check_size(other);
+    rank_valid_ = false;
+    for (std::size_t i = 0; i < words_.size(); ++i) {
+      words_[i] ^= other.words_[i];
+    }
+    return *this;
+  }
+
+  // clear the bits that are set in other, this &= ~other without a copy
+  BitVector &subtract(const BitVector &other) {
+    _check_size(other);
+    rank_valid_ = false;
+    for (std::size_t i = 0; i < words_.size(); ++i) {
+      words_[i] &= ~other.words_[i];
+    }
+    return *this;
+  }
+
+  BitVector operator~() const {
+    BitVector result(*this);
+    result.flip();
+    return result;
+  }
+
+  friend BitVector operator&(BitVector lhs, const BitVector &rhs) {
+    return lhs &= rhs;
+  }
+  friend BitVector operator|(BitVector lhs, const BitVector &rhs) {
+    return lhs |= rhs;
+  }
+  friend BitVector operator^(BitVector lhs, const BitVector &rhs) {
+    return lhs ^= rhs;
+  }
+
+  friend bool operator==(const BitVector &lhs, const BitVector &rhs) {
+    if (lhs.size_ != rhs.size_) {
+      return false;
+    }
+    for (std::size_t i = 0; i < lhs.words_.size(); ++i) {
+      if (lhs.words_[i] != rhs.words_[i]) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // Queries
+  // number of set bits
+  std::size_t count() const {
+    if (rank_valid_) {
+      return rank_.back();
+    }
+    return Simd::popcount(words_.data(), words_.size());
+  }
+
+  bool any() const { return find_first() != size_; }
+  bool none() const { return !any(); }
+  bool all() const { return count() == size_; }
+
+  // position of the first set bit, size() if there is none
+  std::size_t find_first() const { return _scan_from(0); }
+
+  // position of the first set bit after pos, size() if there is none
+  std::size_t find_next(std::size_t pos) const {
+    if (pos + 1 >= size_) {
+      return size_;
+    }
+    const std::size_t next = pos + 1;
+    const std::size_t w = next / word_bits;
+    const word_type word = words_[w] & ~(_bit(next) - 1);
+    if (word != 0) {
+      return w * word_bits + std::countr_zero(word);
+    }
+    return _scan_from(w + 1);
+  }
+
+  // number of set bits in [0, pos)
+  // O(1) with the rank index: one lookup and at most eight popcounts
+  std::size_t rank(std::size_t pos) const {
+    if (pos > size_) {
+      throw std::out_of_range("Index out of range");
+    }
+    const std::size_t w = pos / word_bits;
+    std::size_t result = 0;
+    std::size_t first = 0;
+    if (rank_valid_) {
+      result = rank_[w / block_words_];
+      first = w / block_words_ * block_words_;
+    }
+    result += Simd::popcount(words_.data() + first, w - first);
+    if (pos % word_bits != 0) {
+      result += std::popcount(words_[w] & (_bit(pos) - 1));
+    }
+    return result;
+  }
+
+  // position of the set bit with rank k, i.e. the (k + 1)-th set bit,
+  // size() if there are not that many
+  // with the rank index the block is found by binary search
+  std::size_t select(std::size_t k) const {
+    std::size_t w = 0;
+    if (rank_valid_) {
+      if (k >= rank_.back()) {
+        return size_;
+      }
+      // last block whose running count is <= k
+      std::size_t lo = 0;
+      std::size_t hi = rank_.size() - 1;
+      while (hi - lo > 1) {
+        const std::size_t mid = lo + (hi - lo) / 2;
+        if (rank_[mid] <= k) {
+          lo = mid;
+        } else {
+          hi = mid;
+        }
+      }
+      k -= rank_[lo];
+      w = lo * block_words_;
+    }
+
+    for (; w < words_.size(); ++w) {
+      const std::size_t ones = std::popcount(words_[w]);
+      if (k < ones) {
+        word_type word = words_[w];
+        for (; k > 0; --k) {
+          word &= word - 1;
+        }
+        return w * word_bits + std::countr_zero(word);
+      }
+      k -= ones;
+    }
+    return size_;
+  }
+
+  // running counts for rank and select, valid until the next write
+  void build_rank_index() {
+    const std::size_t blocks = (words_.size() + block_words_ - 1) /
+                               block_words_;
+    rank_.resize(blocks + 1);
+    std::size_t total = 0;
+    for (std::size_t b = 0; b < blocks; ++b) {
+      rank_[b] = total;
+      const std::size_t first = b * block_words_;
+      const std::size_t last = first + block_words_ < words_.size()
+                                   ? first + block_words_
+                                   : words_.size();
+      total += Simd::popcount(words_.data() + first, last - first);
+    }
+    rank_[blocks] = total;
+    rank_valid_ = true;
+  }
+
+  bool has_rank_index() const { return rank_valid_; }
+
+  // Word access, for kernels that work on whole words
+  const word_type *data() const { return words_.data(); }
+
+private:
+  // words per rank block, 512 bits is one cache line of words
+  static constexpr std::size_t block_words_ = 8;
+
+  static std::size_t _words_for(std::size_t size) {
+    return (size + word_bits - 1) / word_bits;
+  }
+
+  static word_type _bit(std::size_t index) {
+    return word_type(1) << (index % word_bits);
+  }
+
+  void _clear_tail() {
+    if (size_ % word_bits != 0) {
+      words_.back() &= _bit(size_) - 1;
+    }
+  }
+
+  void _fill(word_type value) {
+    rank_valid_ = false;
+    for (word_type &word : words_) {
+      word = value;
+    }
+  }
+
+  void _check_size(const BitVector &other) const {
+    if (size_ != other.size_) {
+      throw std::invalid_argument("BitVector sizes differ");
+    }
+  }
+
+  // first set bit in words from w on
+  std::size_t _scan_from(std::size_t w) const {
+    for (; w < words_.size(); ++w) {
+      if (words_[w] != 0) {
+        return w * word_bits + std::countr_zero(words_[w]);
+      }
+    }
+    return size_;
+  }
+
+  Vector<word_type> words_;
+  // rank_[b] is the number of set bits before block b, the last entry holds
+  // the total
+  Vector<std::size_t> rank_;
+  std::size_t size_;
+  bool rank_valid_;
+};
+} // namespace Tiny
+
+#endif // TINY_BIT_VECTOR_HPP
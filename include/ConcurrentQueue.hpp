@@ -0,0 +1,694 @@
+#ifndef TINY_CONCURRENT_QUEUE_HPP
+#define TINY_CONCURRENT_QUEUE_HPP
+
+#include "Allocator.hpp"
+#include "Queue.hpp"
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <optional>
+#include <sched.h>
+#include <span>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+namespace Tiny {
+namespace Impl {
+// tell the cpu this is a spin-wait loop, it backs off the pipeline and lets
+// the other hyperthread run
+inline void cpu_relax() {
+#if defined(__x86_64__) || defined(__i386__)
+  __builtin_ia32_pause();
+#elif defined(__aarch64__)
+  asm volatile("yield");
+#endif
+}
+
+// where threads sleep until another thread has made progress for them
+// a wake only costs a syscall when some sleeper is not already being woken:
+// state_ packs the number of sleepers (high half) with the wakes handed out
+// and not yet picked up (low half), so a burst of signals while the woken
+// thread waits for a cpu does not turn into a futex call each
+class Parker {
+public:
+  // retry attempt for a short spin, then a few times giving the cpu away,
+  // which is what lets the other side run when threads outnumber cores,
+  // then sleep between retries until wake is called
+  template <typename Attempt> void wait_until(Attempt &&attempt) {
+    for (int i = 0; i < spins_; ++i) {
+      if (attempt()) {
+        return;
+      }
+      cpu_relax();
+    }
+    for (int i = 0; i < yields_; ++i) {
+      if (attempt()) {
+        return;
+      }
+      sched_yield();
+    }
+    // seq_cst on the register, on every pickup and in the attempt's loads
+    // pairs with the caller of wake: either the attempt that follows sees
+    // its progress or wake sees us as idle and hands out another wake
+    state_.fetch_add(sleeper_, std::memory_order_seq_cst);
+    for (;;) {
+      // the epoch is read before the pending wake is picked up, so a wake
+      // handed out after it moves the epoch and the wait returns at once
+      const std::uint32_t epoch = epoch_.load(std::memory_order_seq_cst);
+      _pick_up(0);
+      if (attempt()) {
+        break;
+      }
+      epoch_.wait(epoch, std::memory_order_relaxed);
+    }
+    _pick_up(sleeper_);
+  }
+
+  // progress for up to count sleepers was published with seq_cst stores,
+  // wake as many as are not already being woken
+  void wake(std::size_t count) {
+    std::uint64_t state = state_.load(std::memory_order_seq_cst);
+    std::uint64_t grant;
+    do {
+      const std::uint64_t idle = (state >> 32) - (state & woken_mask_);
+      grant = std::min<std::uint64_t>(count, idle);
+      if (grant == 0) {
+        return;
+      }
+    } while (!state_.compare_exchange_weak(state, state + grant,
+                                           std::memory_order_seq_cst));
+    epoch_.fetch_add(1, std::memory_order_seq_cst);
+    if (grant == 1) {
+      epoch_.notify_one();
+    } else {
+      epoch_.notify_all();
+    }
+  }
+
+private:
+  static constexpr int spins_ = 128;
+  static constexpr int yields_ = 16;
+  static constexpr std::uint64_t sleeper_ = std::uint64_t(1) << 32;
+  static constexpr std::uint64_t woken_mask_ = sleeper_ - 1;
+
+  // take one pending wake, if any, and leave as the sleeper count says
+  // picking up a wake meant for another sleeper only costs that one a
+  // spurious pass through the loop
+  // seq_cst keeps the pickup ahead of the next attempt's loads; a relaxed
+  // one lets a weakly ordered cpu retry against stale slots while a wake
+  // sees no idle sleeper and skips the notify
+  void _pick_up(std::uint64_t leave) {
+    std::uint64_t state = state_.load(std::memory_order_seq_cst);
+    std::uint64_t next;
+    do {
+      const std::uint64_t sleepers = (state >> 32) - (leave >> 32);
+      std::uint64_t woken = state & woken_mask_;
+      woken = std::min(woken == 0 ? 0 : woken - 1, sleepers);
+      next = (sleepers << 32) | woken;
+    } while (!state_.compare_exchange_weak(state, next,
+                                           std::memory_order_seq_cst));
+  }
+
+  alignas(64) std::atomic<std::uint64_t> state_{0};
+  std::atomic<std::uint32_t> epoch_{0};
+};
+} // namespace Impl
+
+// ==== SPSCQueue Begin Here ====
+// bounded FIFO between exactly one producer thread and one consumer thread,
+// wait-free: every call finishes in a bounded number of steps and fails
+// instead of waiting
+// the producer owns tail_, the consumer owns head_, each on its own cache
+// line; each side also keeps a private copy of the other's index and only
+// reloads it when the copy says the queue is full (producer) or empty
+// (consumer), so in steady state the two cores do not touch each other's
+// cache line for every element
+// the batch calls publish a whole run of elements with one store
+// T only needs to be move constructible
+template <typename T> class SPSCQueue {
+  static_assert(std::is_nothrow_destructible_v<T>,
+                "SPSCQueue elements must not throw from their destructor.");
+
+private:
+  using alloc_traits = std::allocator_traits<Allocator<T>>;
+
+public:
+  // room for at least capacity elements, rounded up to a power of two
+  explicit SPSCQueue(std::size_t capacity)
+      : capacity_(std::bit_ceil(std::max<std::size_t>(capacity, 1))),
+        mask_(capacity_ - 1), slots_(nullptr), tail_(0), cached_head_(0),
+        head_(0), cached_tail_(0) {
+    Allocator<T> alloc;
+    slots_ = alloc_traits::allocate(alloc, capacity_);
+  }
+
+  SPSCQueue(const SPSCQueue &) = delete;
+  SPSCQueue &operator=(const SPSCQueue &) = delete;
+
+  // neither thread may use the queue any more
+  ~SPSCQueue() {
+    const std::size_t tail = tail_.load(std::memory_order_acquire);
+    for (std::size_t i = head_.load(std::memory_order_relaxed); i != tail;
+         ++i) {
+      slots_[i & mask_].~T();
+    }
+    Allocator<T> alloc;
+    alloc_traits::deallocate(alloc, slots_, capacity_);
+  }
+
+  // Producer side
+  // false if the queue is full, args are left untouched then
+  template <typename... Args> bool try_emplace(Args &&...args) {
+    const std::size_t tail = tail_.load(std::memory_order_relaxed);
+    if (tail - cached_head_ == capacity_) {
+      cached_head_ = head_.load(std::memory_order_acquire);
+      if (tail - cached_head_ == capacity_) {
+        return false;
+      }
+    }
+    ::new (static_cast<void *>(slots_ + (tail & mask_)))
+        T(std::forward<Args>(args)...);
+    tail_.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  bool try_push(const T &value) { return try_emplace(value); }
+  bool try_push(T &&value) { return try_emplace(std::move(value)); }
+
+  // move as many of values in as fit, returns how many; the moved-from
+  // elements stay in values
+  std::size_t try_push_n(std::span<T> values) {
+    const std::size_t tail = tail_.load(std::memory_order_relaxed);
+    if (capacity_ - (tail - cached_head_) < values.size()) {
+      cached_head_ = head_.load(std::memory_order_acquire);
+    }
+    const std::size_t count =
+        std::min(values.size(), capacity_ - (tail - cached_head_));
+    for (std::size_t i = 0; i < count; ++i) {
+      ::new (static_cast<void *>(slots_ + ((tail + i) & mask_)))
+          T(std::move(values[i]));
+    }
+    tail_.store(tail + count, std::memory_order_release);
+    return count;
+  }
+
+  // Consumer side
+  // the oldest element, or nothing if the queue is empty
+  std::optional<T> try_pop() {
+    const std::size_t head = head_.load(std::memory_order_relaxed);
+    if (head == cached_tail_) {
+      cached_tail_ = tail_.load(std::memory_order_acquire);
+      if (head == cached_tail_) {
+        return std::nullopt;
+      }
+    }
+    T &slot = slots_[head & mask_];
+    std::optional<T> result(std::move(slot));
+    slot.~T();
+    head_.store(head + 1, std::memory_order_release);
+    return result;
+  }
+
+  // move-assign the oldest element into out, false if the queue is empty
+  bool try_pop(T &out) {
+    const std::size_t head = head_.load(std::memory_order_relaxed);
+    if (head == cached_tail_) {
+      cached_tail_ = tail_.load(std::memory_order_acquire);
+      if (head == cached_tail_) {
+        return false;
+      }
+    }
+    T &slot = slots_[head & mask_];
+    out = std::move(slot);
+    slot.~T();
+    head_.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  // move-assign up to out.size() of the oldest elements into out, returns
+  // how many
+  std::size_t try_pop_n(std::span<T> out) {
+    const std::size_t head = head_.load(std::memory_order_relaxed);
+    if (cached_tail_ - head < out.size()) {
+      cached_tail_ = tail_.load(std::memory_order_acquire);
+    }
+    const std::size_t count = std::min(out.size(), cached_tail_ - head);
+    for (std::size_t i = 0; i < count; ++i) {
+      T &slot = slots_[(head + i) & mask_];
+      out[i] = std::move(slot);
+      slot.~T();
+    }
+    head_.store(head + count, std::memory_order_release);
+    return count;
+  }
+
+  // Either side, snapshots the other thread may change right after
+  std::size_t size() const {
+    const std::size_t head = head_.load(std::memory_order_acquire);
+    return tail_.load(std::memory_order_acquire) - head;
+  }
+
+  bool empty() const { return size() == 0; }
+  std::size_t capacity() const { return capacity_; }
+
+private:
+  // shared and never written after construction
+  const std::size_t capacity_;
+  const std::size_t mask_;
+  T *slots_;
+
+  // written by the producer
+  alignas(64) std::atomic<std::size_t> tail_;
+  std::size_t cached_head_;
+
+  // written by the consumer, the class alignment of 64 keeps whatever
+  // follows the queue off this line
+  alignas(64) std::atomic<std::size_t> head_;
+  std::size_t cached_tail_;
+};
+// ==== SPSCQueue End Here ====
+
+// ==== MPMCQueue Begin Here ====
+// bounded FIFO for any number of producer and consumer threads, after
+// Dmitry Vyukov's array queue: every slot carries a sequence number that
+// says which lap of the ring it is ready for
+//   seq == pos      free, the producer of position pos may fill it
+//   seq == pos + 1  full, the consumer of position pos may empty it
+// a thread claims a position by advancing tail_ or head_ and then owns the
+// slot until it publishes the next sequence number, so producers and
+// consumers only meet on the slots they hand over
+// try_* never wait; push and pop retry them for a short spin and then park
+// on a futex until the other side has moved, nobody holds a position while
+// asleep so a parked thread never stalls the ones still running
+template <typename T> class MPMCQueue {
+  static_assert(std::is_nothrow_move_constructible_v<T> &&
+                    std::is_nothrow_destructible_v<T>,
+                "MPMCQueue elements must move and destroy without throwing.");
+
+private:
+  struct Slot {
+    std::atomic<std::size_t> seq;
+    alignas(T) unsigned char bytes[sizeof(T)];
+
+    T *get() { return reinterpret_cast<T *>(bytes); }
+  };
+
+  using slot_alloc = typename std::allocator_traits<
+      Allocator<T>>::template rebind_alloc<Slot>;
+  using alloc_traits = std::allocator_traits<slot_alloc>;
+
+public:
+  // room for at least capacity elements, rounded up to a power of two
+  explicit MPMCQueue(std::size_t capacity)
+      : capacity_(std::bit_ceil(std::max<std::size_t>(capacity, 2))),
+        mask_(capacity_ - 1), slots_(nullptr), tail_(0), head_(0) {
+    slot_alloc alloc;
+    slots_ = alloc_traits::allocate(alloc, capacity_);
+    for (std::size_t i = 0; i < capacity_; ++i) {
+      ::new (static_cast<void *>(slots_ + i)) Slot;
+      slots_[i].seq.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  MPMCQueue(const MPMCQueue &) = delete;
+  MPMCQueue &operator=(const MPMCQueue &) = delete;
+
+  // no thread may use the queue any more
+  ~MPMCQueue() {
+    const std::size_t tail = tail_.load(std::memory_order_acquire);
+    for (std::size_t i = head_.load(std::memory_order_relaxed); i != tail;
+         ++i) {
+      slots_[i & mask_].get()->~T();
+    }
+    std::destroy(slots_, slots_ + capacity_);
+    slot_alloc alloc;
+    alloc_traits::deallocate(alloc, slots_, capacity_);
+  }
+
+  // Non-blocking
+  // false if the queue is full; a value that may throw while being built
+  // is built before a slot is claimed, so a throw leaves the queue alone
+  template <typename... Args> bool try_emplace(Args &&...args) {
+    if constexpr (!std::is_nothrow_constructible_v<T, Args &&...>) {
+      return try_emplace(T(std::forward<Args>(args)...));
+    } else {
+      std::size_t pos = tail_.load(std::memory_order_relaxed);
+      for (;;) {
+        Slot &slot = slots_[pos & mask_];
+        const std::ptrdiff_t diff = _lag(slot, pos);
+        if (diff == 0) {
+          if (tail_.compare_exchange_weak(pos, pos + 1,
+                                          std::memory_order_relaxed)) {
+            _fill(slot, pos, std::forward<Args>(args)...);
+            not_empty_.wake(1);
+            return true;
+          }
+        } else if (diff < 0) {
+          return false;
+        } else {
+          pos = tail_.load(std::memory_order_relaxed);
+        }
+      }
+    }
+  }
+
+  bool try_push(const T &value) { return try_emplace(value); }
+  bool try_push(T &&value) { return try_emplace(std::move(value)); }
+
+  // the oldest element, or nothing if the queue is empty
+  std::optional<T> try_pop() {
+    std::optional<T> result;
+    std::size_t pos;
+    if (Slot *slot = _claim_front(pos)) {
+      result.emplace(std::move(*slot->get()));
+      _drain(*slot, pos);
+      not_full_.wake(1);
+    }
+    return result;
+  }
+
+  // move-assign the oldest element into out, false if the queue is empty
+  bool try_pop(T &out) {
+    std::size_t pos;
+    Slot *slot = _claim_front(pos);
+    if (slot == nullptr) {
+      return false;
+    }
+    out = std::move(*slot->get());
+    _drain(*slot, pos);
+    not_full_.wake(1);
+    return true;
+  }
+
+  // Bulk, one CAS claims the whole run of free (full) slots at the tail
+  // (head), so fewer elements than asked for may move
+  // move as many of values in as fit, returns how many; the moved-from
+  // elements stay in values
+  std::size_t try_push_n(std::span<T> values) {
+    std::size_t pos;
+    const std::size_t count = _claim_run(tail_, pos, values.size(), 0);
+    for (std::size_t i = 0; i < count; ++i) {
+      _fill(slots_[(pos + i) & mask_], pos + i, std::move(values[i]));
+    }
+    not_empty_.wake(count);
+    return count;
+  }
+
+  // move-assign up to out.size() of the oldest elements into out, returns
+  // how many
+  std::size_t try_pop_n(std::span<T> out) {
+    std::size_t pos;
+    const std::size_t count = _claim_run(head_, pos, out.size(), 1);
+    for (std::size_t i = 0; i < count; ++i) {
+      Slot &slot = slots_[(pos + i) & mask_];
+      out[i] = std::move(*slot.get());
+      _drain(slot, pos + i);
+    }
+    not_full_.wake(count);
+    return count;
+  }
+
+  // Blocking
+  template <typename... Args> void emplace(Args &&...args) {
+    if constexpr (!std::is_nothrow_constructible_v<T, Args &&...>) {
+      emplace(T(std::forward<Args>(args)...));
+    } else {
+      // a failed try_emplace leaves args alone, so they can be passed on
+      // again
+      not_full_.wait_until(
+          [&] { return try_emplace(std::forward<Args>(args)...); });
+    }
+  }
+
+  void push(const T &value) { emplace(value); }
+  void push(T &&value) { emplace(std::move(value)); }
+
+  T pop() {
+    std::optional<T> value;
+    not_empty_.wait_until([&] {
+      value = try_pop();
+      return value.has_value();
+    });
+    return std::move(*value);
+  }
+
+  // Snapshots, other threads may change them right after
+  std::size_t size() const {
+    const std::size_t head = head_.load(std::memory_order_acquire);
+    return tail_.load(std::memory_order_acquire) - head;
+  }
+
+  bool empty() const { return size() == 0; }
+  std::size_t capacity() const { return capacity_; }
+
+private:
+  // how far the slot is from being ready for position pos, negative when
+  // it is still a lap behind
+  // seq_cst pairs with the Parker, see wait_until; on x86 it costs nothing
+  // over acquire
+  static std::ptrdiff_t _lag(const Slot &slot, std::size_t pos) {
+    return static_cast<std::ptrdiff_t>(
+        slot.seq.load(std::memory_order_seq_cst) - pos);
+  }
+
+  // pos was claimed for the slot, store the value and hand it to the
+  // consumer of pos
+  template <typename... Args>
+  void _fill(Slot &slot, std::size_t pos, Args &&...args) {
+    ::new (static_cast<void *>(slot.bytes)) T(std::forward<Args>(args)...);
+    slot.seq.store(pos + 1, std::memory_order_seq_cst);
+  }
+
+  // the value at pos was moved out, hand the slot to the next lap's
+  // producer
+  void _drain(Slot &slot, std::size_t pos) {
+    slot.get()->~T();
+    slot.seq.store(pos + capacity_, std::memory_order_seq_cst);
+  }
+
+  // claim the oldest full slot, nullptr if the queue is empty
+  Slot *_claim_front(std::size_t &pos) {
+    pos = head_.load(std::memory_order_relaxed);
+    for (;;) {
+      Slot &slot = slots_[pos & mask_];
+      const std::ptrdiff_t diff = _lag(slot, pos + 1);
+      if (diff == 0) {
+        if (head_.compare_exchange_weak(pos, pos + 1,
+                                        std::memory_order_relaxed)) {
+          return &slot;
+        }
+      } else if (diff < 0) {
+        return nullptr;
+      } else {
+        pos = head_.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  // advance index over the run of up to limit slots ready for position +
+  // offset (0 for producers, 1 for consumers); returns its length, 0 if
+  // the first slot is a lap behind
+  std::size_t _claim_run(std::atomic<std::size_t> &index, std::size_t &pos,
+                         std::size_t limit, std::size_t offset) {
+    limit = std::min(limit, capacity_);
+    pos = index.load(std::memory_order_relaxed);
+    while (limit != 0) {
+      const std::ptrdiff_t diff = _lag(slots_[pos & mask_], pos + offset);
+      if (diff < 0) {
+        return 0;
+      }
+      if (diff > 0) {
+        pos = index.load(std::memory_order_relaxed);
+        continue;
+      }
+      std::size_t count = 1;
+      while (count < limit &&
+             _lag(slots_[(pos + count) & mask_], pos + count + offset) == 0) {
+        ++count;
+      }
+      if (index.compare_exchange_weak(pos, pos + count,
+                                      std::memory_order_relaxed)) {
+        return count;
+      }
+    }
+    return 0;
+  }
+
+  // shared and never written after construction
+  const std::size_t capacity_;
+  const std::size_t mask_;
+  Slot *slots_;
+
+  // claimed by producers
+  alignas(64) std::atomic<std::size_t> tail_;
+
+  // claimed by consumers
+  alignas(64) std::atomic<std::size_t> head_;
+
+  // parked producers and consumers, each on its own line; the class
+  // alignment of 64 keeps whatever follows the queue off the last one
+  Impl::Parker not_full_;
+  Impl::Parker not_empty_;
+};
+// ==== MPMCQueue End Here ====
+
+// ==== BlockingQueue Begin Here ====
+// unbounded FIFO whose consumers sleep while it is empty
+// a pop spins briefly on the element count before it takes the lock and
+// waits on the condition variable; a push wakes exactly one sleeping
+// consumer and skips the notify when nobody sleeps
+// close() ends the queue: pushes fail from then on, pops still drain what
+// is left and then return nothing instead of waiting
+template <typename T> class BlockingQueue {
+public:
+  BlockingQueue() : size_(0), closed_(false), sleepers_(0) {}
+
+  BlockingQueue(const BlockingQueue &) = delete;
+  BlockingQueue &operator=(const BlockingQueue &) = delete;
+
+  // Producer side, false once the queue is closed
+  template <typename... Args> bool emplace(Args &&...args) {
+    bool wake;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (closed_.load(std::memory_order_relaxed)) {
+        return false;
+      }
+      items_.emplace_back(std::forward<Args>(args)...);
+      size_.store(items_.size(), std::memory_order_relaxed);
+      wake = sleepers_ != 0;
+    }
+    if (wake) {
+      ready_.notify_one();
+    }
+    return true;
+  }
+
+  bool push(const T &value) { return emplace(value); }
+  bool push(T &&value) { return emplace(std::move(value)); }
+
+  // refuse further pushes and wake every waiting consumer
+  void close() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      closed_.store(true, std::memory_order_relaxed);
+    }
+    ready_.notify_all();
+  }
+
+  // Consumer side
+  // the oldest element, waiting for one; nothing once closed and drained
+  std::optional<T> pop() {
+    _spin();
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (_idle()) {
+      ++sleepers_;
+      ready_.wait(lock);
+      --sleepers_;
+    }
+    return _take();
+  }
+
+  // as pop, but gives up and returns nothing after timeout
+  template <typename Rep, typename Period>
+  std::optional<T> pop_for(const std::chrono::duration<Rep, Period> &timeout) {
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    _spin();
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (_idle()) {
+      ++sleepers_;
+      const std::cv_status status = ready_.wait_until(lock, deadline);
+      --sleepers_;
+      if (status == std::cv_status::timeout) {
+        break;
+      }
+    }
+    return _take();
+  }
+
+  // the oldest element if there is one, never waits
+  std::optional<T> try_pop() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return _take();
+  }
+
+  // wait as pop does, then hand over everything queued in one swap: out is
+  // cleared and its blocks become the queue's, so two Deques passed back
+  // and forth stop allocating; returns out.size(), 0 once closed and
+  // drained
+  std::size_t pop_all(Deque<T> &out) {
+    out.clear();
+    _spin();
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (_idle()) {
+      ++sleepers_;
+      ready_.wait(lock);
+      --sleepers_;
+    }
+    items_.swap(out);
+    size_.store(0, std::memory_order_relaxed);
+    return out.size();
+  }
+
+  // Snapshots, other threads may change them right after
+  std::size_t size() const { return size_.load(std::memory_order_relaxed); }
+  bool empty() const { return size() == 0; }
+  bool closed() const { return closed_.load(std::memory_order_relaxed); }
+
+private:
+  // a sleep and wake-up costs a few microseconds, spinning about as long
+  // first catches the push that is already on its way; with a single cpu
+  // the pusher cannot run while we spin, so we do not
+  static constexpr int spins_ = 2048;
+
+  void _spin() const {
+    static const bool worth_it = std::thread::hardware_concurrency() > 1;
+    if (!worth_it) {
+      return;
+    }
+    for (int i = 0; i < spins_; ++i) {
+      if (size_.load(std::memory_order_relaxed) != 0 ||
+          closed_.load(std::memory_order_relaxed)) {
+        return;
+      }
+      Impl::cpu_relax();
+    }
+  }
+
+  // empty and still open, the lock is held
+  bool _idle() const {
+    return items_.empty() && !closed_.load(std::memory_order_relaxed);
+  }
+
+  // the lock is held
+  std::optional<T> _take() {
+    if (items_.empty()) {
+      return std::nullopt;
+    }
+    std::optional<T> value(std::move(items_.front()));
+    items_.pop_front();
+    size_.store(items_.size(), std::memory_order_relaxed);
+    return value;
+  }
+
+  std::mutex mutex_;
+  std::condition_variable ready_;
+  Deque<T> items_;
+  // mirrors items_.size() and closed for the lock-free spin
+  std::atomic<std::size_t> size_;
+  std::atomic<bool> closed_;
+  // consumers waiting on ready_, guarded by mutex_
+  std::size_t sleepers_;
+};
+// ==== BlockingQueue End Here ====
+} // namespace Tiny
+
+#endif // TINY_CONCURRENT_QUEUE_HPP
@@ -0,0 +1,195 @@
+#ifndef TINY_CONCURRENT_STACK_HPP
+#define TINY_CONCURRENT_STACK_HPP
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace Tiny {
+// lock-free LIFO stack (Treiber) for any number of pushing and popping
+// threads
+// nodes live in blocks that are only freed by the destructor, popped nodes
+// go to a free list and are reused by later pushes, so a thread that read
+// a node just before another thread popped it still reads valid memory
+// ABA is handled by tagging: the heads hold a 32 bit node index and a
+// 32 bit counter in one 64 bit word, and every successful CAS bumps the
+// counter, so a head that was popped and pushed back no longer compares
+// equal; this needs no double-width CAS
+// at most 2^32 - 1 nodes are ever allocated
+template <typename T> class ConcurrentStack {
+  static_assert(std::is_nothrow_move_constructible_v<T>,
+                "ConcurrentStack needs a nothrow move constructor for "
+                "try_pop.");
+
+private:
+  using index_type = std::uint32_t;
+  static constexpr index_type nil_ = ~index_type(0);
+  // block b holds first_block_ << b nodes
+  static constexpr std::size_t first_shift_ = 6;
+  static constexpr std::size_t first_block_ = std::size_t(1) << first_shift_;
+  static constexpr std::size_t max_blocks_ = 33 - first_shift_;
+
+  struct Node {
+    // read by threads that lost the race for this node, hence atomic
+    std::atomic<index_type> next;
+    alignas(T) unsigned char storage[sizeof(T)];
+
+    T *value() { return std::launder(reinterpret_cast<T *>(storage)); }
+  };
+
+public:
+  ConcurrentStack() noexcept
+      : head_(_pack(nil_, 0)), free_(_pack(nil_, 0)), allocated_(0) {
+    for (std::atomic<Node *> &block : blocks_) {
+      block.store(nullptr, std::memory_order_relaxed);
+    }
+  }
+
+  ConcurrentStack(const ConcurrentStack &) = delete;
+  ConcurrentStack &operator=(const ConcurrentStack &) = delete;
+
+  // no other thread may use the stack any more
+  ~ConcurrentStack() {
+    for (index_type index = _index(head_.load(std::memory_order_acquire));
+         index != nil_;) {
+      Node &node = _node(index);
+      node.value()->~T();
+      index = node.next.load(std::memory_order_relaxed);
+    }
+    for (std::size_t b = 0; b < max_blocks_; ++b) {
+      delete[] blocks_[b].load(std::memory_order_acquire);
+    }
+  }
+
+  void push(const T &value) { emplace(value); }
+  void push(T &&value) { emplace(std::move(value)); }
+
+  // only allocates when the free list is empty, a throwing constructor
+  // leaves the stack unchanged
+  template <typename... Args> void emplace(Args &&...args) {
+    const index_type index = _acquire_node();
+    Node &node = _node(index);
+    try {
+      ::new (static_cast<void *>(node.storage))
+          T(std::forward<Args>(args)...);
+    } catch (...) {
+      _push(free_, index);
+      throw;
+    }
+    _push(head_, index);
+  }
+
+  // the top value moved out, or nothing if the stack was empty
+  std::optional<T> try_pop() {
+    const index_type index = _pop(head_);
+    if (index == nil_) {
+      return std::nullopt;
+    }
+    Node &node = _node(index);
+    std::optional<T> result(std::move(*node.value()));
+    node.value()->~T();
+    _push(free_, index);
+    return result;
+  }
+
+  // a snapshot, other threads may change it right after
+  bool empty() const {
+    return _index(head_.load(std::memory_order_acquire)) == nil_;
+  }
+
+private:
+  static std::uint64_t _pack(index_type index, std::uint32_t tag) {
+    return static_cast<std::uint64_t>(tag) << 32 | index;
+  }
+
+  static index_type _index(std::uint64_t head) {
+    return static_cast<index_type>(head);
+  }
+
+  static std::uint32_t _tag(std::uint64_t head) {
+    return static_cast<std::uint32_t>(head >> 32);
+  }
+
+  // nodes are laid out in doubling blocks like StableVector
+  static std::size_t _block_of(index_type index) {
+    return std::bit_width(index + first_block_) - 1 - first_shift_;
+  }
+
+  Node &_node(index_type index) const {
+    const std::size_t n = index + first_block_;
+    const std::size_t b = std::bit_width(n) - 1;
+    Node *block = blocks_[b - first_shift_].load(std::memory_order_acquire);
+    return block[n - (std::size_t(1) << b)];
+  }
+
+  // the release CAS publishes the node's value and next to the thread
+  // that pops it
+  void _push(std::atomic<std::uint64_t> &head, index_type index) {
+    Node &node = _node(index);
+    std::uint64_t old = head.load(std::memory_order_relaxed);
+    do {
+      node.next.store(_index(old), std::memory_order_relaxed);
+    } while (!head.compare_exchange_weak(old, _pack(index, _tag(old) + 1),
+                                         std::memory_order_release,
+                                         std::memory_order_relaxed));
+  }
+
+  // next may be stale if the node was taken meanwhile, the tag makes the
+  // CAS fail in that case
+  index_type _pop(std::atomic<std::uint64_t> &head) {
+    std::uint64_t old = head.load(std::memory_order_acquire);
+    while (_index(old) != nil_) {
+      const index_type next =
+          _node(_index(old)).next.load(std::memory_order_relaxed);
+      if (head.compare_exchange_weak(old, _pack(next, _tag(old) + 1),
+                                     std::memory_order_acquire,
+                                     std::memory_order_acquire)) {
+        return _index(old);
+      }
+    }
+    return nil_;
+  }
+
+  // a recycled node, or a fresh one, allocating its block if this is the
+  // first node in it; racing allocators keep whichever block was
+  // installed first
+  index_type _acquire_node() {
+    const index_type recycled = _pop(free_);
+    if (recycled != nil_) {
+      return recycled;
+    }
+    const std::uint64_t fresh =
+        allocated_.fetch_add(1, std::memory_order_relaxed);
+    if (fresh >= nil_) {
+      throw std::bad_alloc();
+    }
+    const auto index = static_cast<index_type>(fresh);
+    std::atomic<Node *> &slot = blocks_[_block_of(index)];
+    if (slot.load(std::memory_order_acquire) == nullptr) {
+      auto block = std::make_unique<Node[]>(first_block_
+                                            << _block_of(index));
+      Node *expected = nullptr;
+      if (slot.compare_exchange_strong(expected, block.get(),
+                                       std::memory_order_acq_rel)) {
+        block.release();
+      }
+    }
+    return index;
+  }
+
+  // the hot words each get their own cache line
+  alignas(64) std::atomic<std::uint64_t> head_;
+  alignas(64) std::atomic<std::uint64_t> free_;
+  // 64 bits so that failed attempts past the limit cannot wrap around
+  alignas(64) std::atomic<std::uint64_t> allocated_;
+  std::atomic<Node *> blocks_[max_blocks_];
+};
+} // namespace Tiny
+
+#endif // TINY_CONCURRENT_STACK_HPP
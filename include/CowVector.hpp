@@ -0,0 +1,167 @@
+#ifndef TINY_COW_VECTOR_HPP
+#define TINY_COW_VECTOR_HPP
+
+#include "Vector.hpp"
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <utility>
+
+namespace Tiny {
+// copy-on-write Vector: copies share one buffer through an atomic reference
+// count and cost O(1); the first write through a shared copy detaches it
+// with a deep copy
+// reads and writes are separate on purpose: every accessor is const and
+// never copies, writes go through the modifiers below or through edit(),
+// which hands out the detached Vector itself
+// like SharedPtr, different CowVectors sharing a buffer may be used from
+// different threads, one CowVector may not
+template <typename T, typename Alloc = Allocator<T>> class CowVector {
+private:
+  // the count and the Vector share one allocation
+  struct Shared {
+    template <typename... Args>
+    explicit Shared(Args &&...args)
+        : refs(1), vec(std::forward<Args>(args)...) {}
+
+    std::atomic<std::size_t> refs;
+    Vector<T, Alloc> vec;
+  };
+
+public:
+  using iterator = const T *;
+  using const_iterator = const T *;
+
+  CowVector() noexcept : shared_(nullptr) {}
+
+  CowVector(std::size_t size, const T &value)
+      : shared_(new Shared(size, value)) {}
+
+  CowVector(const T *first, const T *last) : shared_(new Shared(first, last)) {}
+
+  // take over a Vector without copying it
+  explicit CowVector(Vector<T, Alloc> &&vec)
+      : shared_(new Shared(std::move(vec))) {}
+
+  CowVector(const CowVector &other) noexcept : shared_(other.shared_) {
+    _acquire();
+  }
+
+  CowVector(CowVector &&other) noexcept
+      : shared_(std::exchange(other.shared_, nullptr)) {}
+
+  ~CowVector() { _release(); }
+
+  CowVector &operator=(const CowVector &other) noexcept {
+    if (shared_ != other.shared_) {
+      _release();
+      shared_ = other.shared_;
+      _acquire();
+    }
+    return *this;
+  }
+
+  CowVector &operator=(CowVector &&other) noexcept {
+    if (this != &other) {
+      _release();
+      shared_ = std::exchange(other.shared_, nullptr);
+    }
+    return *this;
+  }
+
+  // Read access, never copies
+  const T &operator[](std::size_t index) const { return view()[index]; }
+  const T &at(std::size_t index) const { return view().at(index); }
+  const T &front() const { return view().front(); }
+  const T &back() const { return view().back(); }
+  const T *data() const { return view().data(); }
+
+  const_iterator begin() const { return view().begin(); }
+  const_iterator end() const { return view().end(); }
+  const_iterator cbegin() const { return view().cbegin(); }
+  const_iterator cend() const { return view().cend(); }
+
+  std::size_t size() const { return view().size(); }
+  std::size_t capacity() const { return view().capacity(); }
+  bool empty() const { return view().empty(); }
+
+  // the shared Vector, read only
+  const Vector<T, Alloc> &view() const {
+    return shared_ != nullptr ? shared_->vec : _empty();
+  }
+
+  // number of CowVectors sharing the buffer, 0 for an empty default one
+  std::size_t use_count() const {
+    return shared_ != nullptr ? shared_->refs.load(std::memory_order_acquire)
+                              : 0;
+  }
+
+  bool unique() const { return use_count() == 1; }
+
+  // Write access, detaches first
+  // the Vector owned by this CowVector alone, valid until it is copied
+  Vector<T, Alloc> &edit() {
+    _detach();
+    return shared_->vec;
+  }
+
+  void set(std::size_t index, const T &value) { edit().at(index) = value; }
+  void set(std::size_t index, T &&value) {
+    edit().at(index) = std::move(value);
+  }
+
+  template <typename... Args> void emplace_back(Args &&...args) {
+    edit().emplace_back(std::forward<Args>(args)...);
+  }
+
+  void push_back(const T &value) { edit().push_back(value); }
+  void push_back(T &&value) { edit().push_back(std::move(value)); }
+  void pop_back() { edit().pop_back(); }
+  void resize(std::size_t size) { edit().resize(size); }
+  void reserve(std::size_t capacity) { edit().reserve(capacity); }
+
+  // dropping the contents never needs a copy
+  void clear() {
+    _release();
+    shared_ = nullptr;
+  }
+
+  void swap(CowVector &other) noexcept { std::swap(shared_, other.shared_); }
+
+private:
+  static const Vector<T, Alloc> &_empty() {
+    static const Vector<T, Alloc> empty;
+    return empty;
+  }
+
+  void _acquire() {
+    if (shared_ != nullptr) {
+      shared_->refs.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+
+  // the last owner has to see every write other owners made before
+  // letting go, hence acq_rel
+  void _release() {
+    if (shared_ != nullptr &&
+        shared_->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      delete shared_;
+    }
+  }
+
+  // make shared_ a buffer only this CowVector refers to
+  void _detach() {
+    if (shared_ == nullptr) {
+      shared_ = new Shared();
+    } else if (shared_->refs.load(std::memory_order_acquire) != 1) {
+      Shared *copy = new Shared(shared_->vec);
+      _release();
+      shared_ = copy;
+    }
+  }
+
+  Shared *shared_;
+};
+} // namespace Tiny
+
+#endif // TINY_COW_VECTOR_HPP
@@ -0,0 +1,331 @@
+#ifndef TINY_EXPR_HPP
+#define TINY_EXPR_HPP
+
+#include "Array.hpp"
+#include "Vector.hpp"
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+
+// Lazy elementwise arithmetic over Array<T, N> and Vector<T> of arithmetic
+// T. An expression such as a + b * c only records its operands; the work
+// happens in one fused loop when it is assigned, so there are no temporary
+// containers and the loop vectorizes like a hand-written one.
+// The operators are opt-in: write `using namespace Tiny::Expr;` to use them.
+// Expressions refer to their containers, which must outlive them.
+namespace Tiny {
+namespace Expr {
+// base of every expression node
+struct Node {};
+
+namespace Impl {
+template <typename C> struct container_traits {
+  static constexpr bool is_container = false;
+};
+
+template <typename T, std::size_t N> struct container_traits<Array<T, N>> {
+  static constexpr bool is_container = std::is_arithmetic_v<T>;
+  static constexpr std::size_t extent = N;
+};
+
+template <typename T, typename Alloc, typename Grow>
+struct container_traits<Vector<T, Alloc, Grow>> {
+  static constexpr bool is_container = std::is_arithmetic_v<T>;
+  static constexpr std::size_t extent = 0;
+};
+} // namespace Impl
+
+template <typename C>
+concept Container =
+    Impl::container_traits<std::remove_cvref_t<C>>::is_container;
+
+// things that have elements: nodes and containers
+template <typename E>
+concept Operand =
+    std::is_base_of_v<Node, std::remove_cvref_t<E>> || Container<E>;
+
+// operands plus plain numbers, which are broadcast
+template <typename E>
+concept AnyOperand =
+    Operand<E> || std::is_arithmetic_v<std::remove_cvref_t<E>>;
+
+// ==== Nodes Begin Here ====
+// a container's elements, read through a pointer
+template <typename T, std::size_t Extent> class Leaf : public Node {
+public:
+  using value_type = T;
+  static constexpr std::size_t extent = Extent;
+  static constexpr bool is_scalar = false;
+
+  Leaf(const T *data, std::size_t size) : data_(data), size_(size) {}
+
+  T operator[](std::size_t index) const { return data_[index]; }
+  std::size_t size() const { return size_; }
+
+private:
+  const T *data_;
+  std::size_t size_;
+};
+
+// a number standing in for every element
+template <typename T> class Scalar : public Node {
+public:
+  using value_type = T;
+  static constexpr std::size_t extent = 0;
+  static constexpr bool is_scalar = true;
+
+  explicit Scalar(T value) : value_(value) {}
+
+  T operator[](std::size_t) const { return value_; }
+  std::size_t size() const { return 0; }
+
+private:
+  T value_;
+};
+
+// op applied to the elements of every operand at the same index
+// all non-scalar operands must have the same size
+template <typename Op, typename... Es> class Map : public Node {
+public:
+  using value_type = std::remove_cvref_t<decltype(Op::apply(
+      std::declval<typename Es::value_type>()...))>;
+  static constexpr std::size_t extent = [] {
+    std::size_t result = 0;
+    ((result = Es::extent != 0 ? Es::extent : result), ...);
+    return result;
+  }();
+  static constexpr bool is_scalar = (Es::is_scalar && ...);
+
+  explicit Map(const Es &...operands) : operands_(operands...), size_(0) {
+    bool sized = false;
+    auto check = [&](const auto &operand) {
+      if (std::remove_cvref_t<decltype(operand)>::is_scalar) {
+        return;
+      }
+      if (sized && operand.size() != size_) {
+        throw std::invalid_argument("Expression sizes differ");
+      }
+      sized = true;
+      size_ = operand.size();
+    };
+    (check(operands), ...);
+  }
+
+  value_type operator[](std::size_t index) const {
+    return std::apply(
+        [index](const Es &...operands) {
+          return Op::apply(operands[index]...);
+        },
+        operands_);
+  }
+
+  std::size_t size() const { return size_; }
+
+private:
+  std::tuple<Es...> operands_;
+  std::size_t size_;
+};
+// ==== Nodes End Here ====
+
+namespace Impl {
+struct Add {
+  template <typename A, typename B> static auto apply(A a, B b) {
+    return a + b;
+  }
+};
+struct Sub {
+  template <typename A, typename B> static auto apply(A a, B b) {
+    return a - b;
+  }
+};
+struct Mul {
+  template <typename A, typename B> static auto apply(A a, B b) {
+    return a * b;
+  }
+};
+struct Div {
+  template <typename A, typename B> static auto apply(A a, B b) {
+    return a / b;
+  }
+};
+struct Neg {
+  template <typename A> static auto apply(A a) { return -a; }
+};
+// written as a * b + c so the compiler contracts it into an FMA instruction
+// wherever the target has one, std::fma would be a libm call otherwise
+struct Fma {
+  template <typename A, typename B, typename C>
+  static auto apply(A a, B b, C c) {
+    return a * b + c;
+  }
+};
+
+// turn any operand into a node
+template <typename E> auto node(const E &operand) {
+  using D = std::remove_cvref_t<E>;
+  if constexpr (std::is_base_of_v<Node, D>) {
+    return operand;
+  } else if constexpr (std::is_arithmetic_v<D>) {
+    return Scalar<D>(operand);
+  } else {
+    using T = std::remove_cvref_t<decltype(*operand.data())>;
+    return Leaf<T, container_traits<D>::extent>(operand.data(),
+                                                operand.size());
+  }
+}
+
+template <typename E> using node_t = decltype(node(std::declval<E>()));
+
+template <typename Op, typename... Es> auto make(const Es &...operands) {
+  return Map<Op, node_t<Es>...>(node(operands)...);
+}
+
+// sum of f(i) over [0, size) with eight independent accumulators, which is
+// the reassociation a vectorized reduction needs and the compiler may not
+// do on its own for floating point
+template <typename T, typename F> T reduce(std::size_t size, F f) {
+  T acc[8] = {};
+  std::size_t i = 0;
+  for (; i + 8 <= size; i += 8) {
+    for (std::size_t k = 0; k < 8; ++k) {
+      acc[k] += f(i + k);
+    }
+  }
+  for (; i < size; ++i) {
+    acc[0] += f(i);
+  }
+  return ((acc[0] + acc[1]) + (acc[2] + acc[3])) +
+         ((acc[4] + acc[5]) + (acc[6] + acc[7]));
+}
+
+template <typename C, typename E> void check_size(const C &dst, const E &e) {
+  if (!E::is_scalar && dst.size() != e.size()) {
+    throw std::invalid_argument("Expression sizes differ");
+  }
+}
+} // namespace Impl
+
+// ==== Operators Begin Here ====
+template <AnyOperand A, AnyOperand B>
+  requires(Operand<A> || Operand<B>)
+auto operator+(const A &a, const B &b) {
+  return Impl::make<Impl::Add>(a, b);
+}
+
+template <AnyOperand A, AnyOperand B>
+  requires(Operand<A> || Operand<B>)
+auto operator-(const A &a, const B &b) {
+  return Impl::make<Impl::Sub>(a, b);
+}
+
+template <AnyOperand A, AnyOperand B>
+  requires(Operand<A> || Operand<B>)
+auto operator*(const A &a, const B &b) {
+  return Impl::make<Impl::Mul>(a, b);
+}
+
+template <AnyOperand A, AnyOperand B>
+  requires(Operand<A> || Operand<B>)
+auto operator/(const A &a, const B &b) {
+  return Impl::make<Impl::Div>(a, b);
+}
+
+template <Operand A> auto operator-(const A &a) {
+  return Impl::make<Impl::Neg>(a);
+}
+
+// a * b + c in one step
+template <AnyOperand A, AnyOperand B, AnyOperand C>
+  requires(Operand<A> || Operand<B> || Operand<C>)
+auto fma(const A &a, const B &b, const C &c) {
+  return Impl::make<Impl::Fma>(a, b, c);
+}
+// ==== Operators End Here ====
+
+// ==== Evaluation Begin Here ====
+// dst[i] = e[i] in one loop, a Vector is resized to fit, an Array must
+// already have the right size
+// e may read dst itself, every element only depends on its own index
+template <Container C, AnyOperand E> C &assign(C &dst, const E &e) {
+  const auto expr = Impl::node(e);
+  if constexpr (Impl::container_traits<C>::extent == 0) {
+    if (!decltype(expr)::is_scalar && dst.size() != expr.size()) {
+      dst.resize(expr.size());
+    }
+  } else {
+    Impl::check_size(dst, expr);
+  }
+  auto *data = dst.data();
+  const std::size_t size = dst.size();
+  // blocks of eight with a fixed inner count get vectorized even at -O2,
+  // where GCC leaves a plain loop of unknown length scalar
+  // distinct containers never overlap and element i only reads index i, so
+  // nothing in a block depends on another element of it
+  std::size_t i = 0;
+  for (; i + 8 <= size; i += 8) {
+#pragma GCC ivdep
+    for (std::size_t k = 0; k < 8; ++k) {
+      data[i + k] = expr[i + k];
+    }
+  }
+  for (; i < size; ++i) {
+    data[i] = expr[i];
+  }
+  return dst;
+}
+
+// a new container holding the values of e, an Array when any operand is one
+template <Operand E> auto eval(const E &e) {
+  const auto expr = Impl::node(e);
+  using E_ = std::remove_const_t<decltype(expr)>;
+  using T = typename E_::value_type;
+  if constexpr (E_::extent != 0) {
+    Array<T, E_::extent> result;
+    return assign(result, expr);
+  } else {
+    Vector<T> result(expr.size());
+    return assign(result, expr);
+  }
+}
+
+template <Container C, AnyOperand E> C &operator+=(C &dst, const E &e) {
+  return assign(dst, dst + e);
+}
+
+template <Container C, AnyOperand E> C &operator-=(C &dst, const E &e) {
+  return assign(dst, dst - e);
+}
+
+template <Container C, AnyOperand E> C &operator*=(C &dst, const E &e) {
+  return assign(dst, dst * e);
+}
+
+template <Container C, AnyOperand E> C &operator/=(C &dst, const E &e) {
+  return assign(dst, dst / e);
+}
+// ==== Evaluation End Here ====
+
+// ==== Reductions Begin Here ====
+template <Operand E> auto sum(const E &e) {
+  const auto expr = Impl::node(e);
+  using T = typename decltype(expr)::value_type;
+  return Impl::reduce<T>(expr.size(),
+                         [&](std::size_t i) { return expr[i]; });
+}
+
+template <Operand A, Operand B> auto dot(const A &a, const B &b) {
+  return sum(a * b);
+}
+
+// Euclidean length
+template <Operand E> auto norm(const E &e) {
+  using std::sqrt;
+  return sqrt(dot(e, e));
+}
+// ==== Reductions End Here ====
+} // namespace Expr
+} // namespace Tiny
+
+#endif // TINY_EXPR_HPP
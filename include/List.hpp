@@ -38,7 +38,7 @@ template <typename T> struct ListNode {
   }
 
   ListNode &operator=(T &&val) {
-    data = std::forward(val);
+    data = std::move(val);
     return *this;
   }
 
@@ -161,7 +161,7 @@ public:
   T &back() { return m_tail->data; }
 
   void push_front(T &&val) {
-    ListNode<T> *newNode = new ListNode<T>(std::forward(val));
+    ListNode<T> *newNode = new ListNode<T>(std::move(val));
     newNode->next = m_head;
     m_head->prev = newNode;
     m_head = newNode;
@@ -205,12 +205,12 @@ public:
 
   void push_back(T &&val) {
     if (m_head) {
-      m_tail->next = new ListNode<T>(std::forward(val));
+      m_tail->next = new ListNode<T>(std::move(val));
       m_tail->next->prev = m_tail;
       m_tail = m_tail->next;
       ++m_size;
     } else {
-      m_head = new ListNode<T>(std::forward(val));
+      m_head = new ListNode<T>(std::move(val));
       m_tail = m_head;
       ++m_size;
     }
@@ -280,15 +280,15 @@ public:
       throw std::out_of_range("Index out of range");
     }
     if (index == 0) {
-      push_front(std::forward(val));
+      push_front(std::move(val));
     } else if (index == m_size) {
-      push_back(std::forward(val));
+      push_back(std::move(val));
     } else {
       ListNode<T> *curr = m_head;
       for (std::size_t i = 0; i < index; ++i) {
         curr = curr->next;
       }
-      ListNode<T> *newNode = new ListNode<T>(std::forward(val));
+      ListNode<T> *newNode = new ListNode<T>(std::move(val));
       curr->insert(newNode);
       ++m_size;
     }
@@ -479,7 +479,7 @@ public:
   }
 
   forwardListNode &operator=(T &&val) {
-    data = std::forward(val);
+    data = std::move(val);
     return *this;
   }
 
@@ -605,7 +605,7 @@ public:
   }
 
   void push_front(T &&val) {
-    forwardListNode<T> *newNode = new forwardListNode<T>(std::forward(val));
+    forwardListNode<T> *newNode = new forwardListNode<T>(std::move(val));
     newNode->next = m_head;
     m_head = newNode;
     ++m_size;
@@ -617,10 +617,10 @@ public:
       while (curr->next) {
         curr = curr->next;
       }
-      curr->next = new forwardListNode<T>(std::forward(val));
+      curr->next = new forwardListNode<T>(std::move(val));
       ++m_size;
     } else {
-      m_head = new forwardListNode<T>(std::forward(val));
+      m_head = new forwardListNode<T>(std::move(val));
       ++m_size;
     }
   }
@@ -673,15 +673,15 @@ public:
       throw std::out_of_range("Index out of range");
     }
     if (index == 0) {
-      push_front(std::forward(val));
+      push_front(std::move(val));
     } else if (index == m_size) {
-      push_back(std::forward(val));
+      push_back(std::move(val));
     } else {
       forwardListNode<T> *curr = m_head;
       for (std::size_t i = 0; i < index - 1; ++i) {
         curr = curr->next;
       }
-      forwardListNode<T> *newNode = new forwardListNode<T>(std::forward(val));
+      forwardListNode<T> *newNode = new forwardListNode<T>(std::move(val));
       newNode->next = curr->next;
       curr->next = newNode;
       ++m_size;
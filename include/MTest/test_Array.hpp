@@ -2,6 +2,7 @@
 #define TEST_TINY_ARRAY_HPP
 
 #include "../Array.hpp"
+#include <cstdint>
 #include <iostream>
 
 namespace Tiny {
@@ -32,6 +33,48 @@ inline void test_Array() {
   arr4 = arr3;
   print_array(arr4);
 }
+
+// a CRC-32 table built entirely by the compiler
+inline constexpr Tiny::Array<std::uint32_t, 256> crc_table = [] {
+  Tiny::Array<std::uint32_t, 256> table{};
+  table.generate([](std::size_t i) {
+    std::uint32_t crc = static_cast<std::uint32_t>(i);
+    for (int bit = 0; bit < 8; bit++) {
+      crc = (crc & 1) ? 0xEDB88320u ^ (crc >> 1) : crc >> 1;
+    }
+    return crc;
+  });
+  return table;
+}();
+
+inline void test_Array_constexpr() {
+  static_assert(crc_table[1] == 0x77073096u);
+
+  constexpr auto keys = [] {
+    Tiny::Array keys{42, 7, 19, 3, 88};
+    keys.sort();
+    return keys;
+  }();
+  static_assert(keys.find(19) == 2 && keys.find(5) == keys.size());
+  print_array(keys);
+
+  constexpr auto squares = [] {
+    Tiny::Array<int, 4> result{};
+    result.iota(1);
+    for (int &value : result) {
+      value *= value;
+    }
+    return result;
+  }();
+  auto [a, b, c, d] = squares;
+  std::cout << a << ' ' << b << ' ' << c << ' ' << d << std::endl;
+
+  constexpr int raw[] = {3, 1, 2};
+  constexpr auto copied = Tiny::to_array(raw);
+  static_assert(copied == Tiny::Array{3, 1, 2});
+  std::cout << "crc_table[255]: " << std::hex << crc_table[255] << std::dec
+            << std::endl;
+}
 } // namespace TestArray
 } // namespace Tiny
 
@@ -0,0 +1,50 @@
+#ifndef TEST_TINY_BIT_VECTOR_HPP
+#define TEST_TINY_BIT_VECTOR_HPP
+
+#include "../BitVector.hpp"
+#include <iostream>
+
+namespace Tiny {
+namespace TestBitVector {
+inline void print_bits(const Tiny::BitVector &bits) {
+  for (std::size_t i = 0; i < bits.size(); i++) {
+    std::cout << bits[i];
+  }
+  std::cout << " (count: " << bits.count() << ')' << std::endl;
+}
+
+inline void test_BitVector() {
+  Tiny::BitVector evens(20);
+  Tiny::BitVector threes(20);
+  for (std::size_t i = 0; i < 20; i++) {
+    evens.set(i, i % 2 == 0);
+    threes.set(i, i % 3 == 0);
+  }
+  print_bits(evens);
+  print_bits(threes);
+  print_bits(evens & threes);
+  print_bits(evens | threes);
+  print_bits(evens ^ threes);
+  print_bits(~evens);
+
+  std::cout << "Set in threes:";
+  for (std::size_t i = threes.find_first(); i < threes.size();
+       i = threes.find_next(i)) {
+    std::cout << ' ' << i;
+  }
+  std::cout << std::endl;
+
+  // a mask spanning many words, rank and select through the index
+  Tiny::BitVector mask(100000);
+  for (std::size_t i = 0; i < mask.size(); i += 7) {
+    mask.set(i);
+  }
+  mask.build_rank_index();
+  std::cout << "Mask count: " << mask.count()
+            << ", rank(70000): " << mask.rank(70000)
+            << ", select(10000): " << mask.select(10000) << std::endl;
+}
+} // namespace TestBitVector
+} // namespace Tiny
+
+#endif // TEST_TINY_BIT_VECTOR_HPP
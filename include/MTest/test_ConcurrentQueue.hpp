@@ -0,0 +1,167 @@
+#ifndef TEST_TINY_CONCURRENT_QUEUE_HPP
+#define TEST_TINY_CONCURRENT_QUEUE_HPP
+
+#include "../ConcurrentQueue.hpp"
+#include "../Thread.hpp"
+#include "../UniquePtr.hpp"
+#include "../Vector.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <optional>
+#include <sched.h>
+#include <span>
+#include <string>
+
+namespace Tiny {
+namespace TestConcurrentQueue {
+inline void test_SPSCQueue() {
+  // move-only elements go through by move
+  Tiny::SPSCQueue<Tiny::UniquePtr<int>> boxes(3);
+  std::cout << "capacity: " << boxes.capacity() << std::endl;
+  for (int i = 1; i <= 5; i++) {
+    std::cout << boxes.try_push(Tiny::makeUnique<int>(i)) << ' ';
+  }
+  std::cout << "| size: " << boxes.size() << std::endl;
+  Tiny::UniquePtr<int> box;
+  boxes.try_pop(box);
+  std::optional<Tiny::UniquePtr<int>> next = boxes.try_pop();
+  std::cout << "popped " << *box << " and " << **next << std::endl;
+
+  // batches are cut to the room that is left
+  Tiny::SPSCQueue<long> batch(4);
+  long in[] = {1, 2, 3, 4, 5, 6};
+  long out[6] = {};
+  std::cout << "pushed " << batch.try_push_n(in) << ", popped "
+            << batch.try_pop_n(out) << ": " << out[0] << ' ' << out[3]
+            << std::endl;
+
+  // a two stage pipeline must see every value once and in order
+  Tiny::SPSCQueue<long> pipe(64);
+  const long count = 100000;
+  Tiny::Thread producer([&pipe, count] {
+    for (long i = 1; i <= count; i++) {
+      while (!pipe.try_push(i)) {
+        sched_yield();
+      }
+    }
+  });
+  long expected = 1;
+  bool in_order = true;
+  while (expected <= count) {
+    long value;
+    if (!pipe.try_pop(value)) {
+      sched_yield();
+      continue;
+    }
+    in_order = in_order && value == expected;
+    ++expected;
+  }
+  producer.join();
+  std::cout << "In order: " << in_order << ", empty: " << pipe.empty()
+            << std::endl;
+}
+
+inline void test_MPMCQueue() {
+  Tiny::MPMCQueue<std::string> names(4);
+  names.push("first");
+  names.try_emplace(3, 'x');
+  std::string more[] = {"a", "b", "c"};
+  std::cout << "capacity: " << names.capacity()
+            << ", batch pushed: " << names.try_push_n(more)
+            << ", try_push when full: " << names.try_push("d") << std::endl;
+  std::cout << names.pop() << ' ';
+  while (std::optional<std::string> name = names.try_pop()) {
+    std::cout << *name << ' ';
+  }
+  std::cout << "| empty: " << names.empty() << std::endl;
+
+  // fan-out and fan-in through a small queue: blocking producers, one
+  // blocking consumer and two polling in batches, each consumer takes a
+  // fixed share so nobody waits for a value another one took
+  Tiny::MPMCQueue<long> work(16);
+  const int producers = 3;
+  const long per_producer = 20000;
+  const long total = producers * per_producer;
+  const long blocking_share = 1000;
+  const long polling_share = (total - blocking_share) / 2;
+  std::atomic<long> sum(0);
+  Tiny::Vector<Tiny::Thread> pool;
+  for (int t = 0; t < producers; t++) {
+    pool.push_back(Tiny::Thread([&work, t, per_producer] {
+      for (long i = 1; i <= per_producer; i++) {
+        work.push(t * per_producer + i);
+      }
+    }));
+  }
+  pool.push_back(Tiny::Thread([&work, &sum, blocking_share] {
+    for (long i = 0; i < blocking_share; i++) {
+      sum += work.pop();
+    }
+  }));
+  for (int t = 0; t < 2; t++) {
+    pool.push_back(Tiny::Thread([&work, &sum, polling_share] {
+      long batch[8];
+      for (long left = polling_share; left > 0;) {
+        const std::size_t count = work.try_pop_n(
+            std::span<long>(batch, std::min<long>(left, 8)));
+        for (std::size_t k = 0; k < count; k++) {
+          sum += batch[k];
+        }
+        left -= static_cast<long>(count);
+        if (count == 0) {
+          sched_yield();
+        }
+      }
+    }));
+  }
+  for (Tiny::Thread &thread : pool) {
+    thread.join();
+  }
+  std::cout << "Sum matches: " << (sum == total * (total + 1) / 2)
+            << std::endl;
+}
+
+inline void test_BlockingQueue() {
+  Tiny::BlockingQueue<std::string> lines;
+  lines.push("first");
+  lines.emplace(2, 'y');
+  std::cout << *lines.pop() << ' ' << *lines.try_pop()
+            << " | pop_for on empty: "
+            << lines.pop_for(std::chrono::milliseconds(1)).has_value()
+            << std::endl;
+
+  // consumers sleep until work arrives and stop once the queue is closed
+  // and drained, one of them takes whole batches
+  Tiny::BlockingQueue<long> work;
+  std::atomic<long> sum(0);
+  Tiny::Vector<Tiny::Thread> consumers;
+  consumers.push_back(Tiny::Thread([&work, &sum] {
+    while (std::optional<long> value = work.pop()) {
+      sum += *value;
+    }
+  }));
+  consumers.push_back(Tiny::Thread([&work, &sum] {
+    Tiny::Deque<long> batch;
+    while (work.pop_all(batch) != 0) {
+      for (long value : batch) {
+        sum += value;
+      }
+    }
+  }));
+  const long count = 10000;
+  for (long i = 1; i <= count; i++) {
+    work.push(i);
+  }
+  work.close();
+  for (Tiny::Thread &thread : consumers) {
+    thread.join();
+  }
+  std::cout << "Sum matches: " << (sum == count * (count + 1) / 2)
+            << ", push after close: " << work.push(1) << std::endl;
+}
+} // namespace TestConcurrentQueue
+} // namespace Tiny
+
+#endif // TEST_TINY_CONCURRENT_QUEUE_HPP
@@ -0,0 +1,52 @@
+#ifndef TEST_TINY_CONCURRENT_STACK_HPP
+#define TEST_TINY_CONCURRENT_STACK_HPP
+
+#include "../ConcurrentStack.hpp"
+#include "../Thread.hpp"
+#include "../Vector.hpp"
+#include <atomic>
+#include <iostream>
+#include <string>
+
+namespace Tiny {
+namespace TestConcurrentStack {
+inline void test_ConcurrentStack() {
+  Tiny::ConcurrentStack<std::string> names;
+  names.push("first");
+  names.emplace(3, 'x');
+  while (std::optional<std::string> name = names.try_pop()) {
+    std::cout << *name << ' ';
+  }
+  std::cout << "| empty: " << names.empty() << std::endl;
+
+  // producers push disjoint ranges while popping some back, nothing may be
+  // lost or duplicated
+  Tiny::ConcurrentStack<long> work;
+  const int threads = 4;
+  const long per_thread = 20000;
+  std::atomic<long> popped(0);
+  Tiny::Vector<Tiny::Thread> pool;
+  for (int t = 0; t < threads; t++) {
+    pool.push_back(Tiny::Thread([&work, &popped, t, per_thread] {
+      for (long i = 1; i <= per_thread; i++) {
+        work.push(t * per_thread + i);
+        if (i % 3 == 0) {
+          popped += work.try_pop().value_or(0);
+        }
+      }
+    }));
+  }
+  for (Tiny::Thread &thread : pool) {
+    thread.join();
+  }
+  long total = popped;
+  while (std::optional<long> value = work.try_pop()) {
+    total += *value;
+  }
+  const long n = threads * per_thread;
+  std::cout << "Sum matches: " << (total == n * (n + 1) / 2) << std::endl;
+}
+} // namespace TestConcurrentStack
+} // namespace Tiny
+
+#endif // TEST_TINY_CONCURRENT_STACK_HPP
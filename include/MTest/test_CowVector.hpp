@@ -0,0 +1,37 @@
+#ifndef TEST_TINY_COW_VECTOR_HPP
+#define TEST_TINY_COW_VECTOR_HPP
+
+#include "../CowVector.hpp"
+#include <iostream>
+#include <string>
+
+namespace Tiny {
+namespace TestCowVector {
+inline void test_CowVector() {
+  Tiny::CowVector<std::string> config(3, "default");
+  Tiny::CowVector<std::string> reader_a = config;
+  Tiny::CowVector<std::string> reader_b = config;
+  std::cout << "Shared by " << config.use_count() << ", same buffer: "
+            << (reader_a.data() == config.data()) << std::endl;
+
+  // the first write detaches, the other copies keep the old contents
+  reader_b.set(1, "override");
+  reader_b.push_back("extra");
+  std::cout << "After write, config shared by " << config.use_count()
+            << ", reader_b unique: " << reader_b.unique() << std::endl;
+  for (const std::string &value : reader_b) {
+    std::cout << value << ' ';
+  }
+  std::cout << "| " << config[1] << std::endl;
+
+  // edit() hands out the detached Vector for bulk changes
+  Tiny::Vector<std::string> &vec = reader_a.edit();
+  vec.insert(vec.begin(), "first");
+  std::cout << "reader_a: " << reader_a.front() << ' ' << reader_a.size()
+            << ", config: " << config.front() << ' ' << config.size()
+            << std::endl;
+}
+} // namespace TestCowVector
+} // namespace Tiny
+
+#endif // TEST_TINY_COW_VECTOR_HPP
@@ -0,0 +1,46 @@
+#ifndef TEST_TINY_EXPR_HPP
+#define TEST_TINY_EXPR_HPP
+
+#include "../Expr.hpp"
+#include <iostream>
+
+namespace Tiny {
+namespace TestExpr {
+inline void test_Expr() {
+  using namespace Tiny::Expr;
+
+  Tiny::Vector<float> x(6), y(6);
+  for (std::size_t i = 0; i < x.size(); i++) {
+    x[i] = static_cast<float>(i);
+    y[i] = 1.0f;
+  }
+
+  // one loop, no temporaries, dst is resized to fit
+  Tiny::Vector<float> dst;
+  assign(dst, 2.0f * x + y / 2.0f - 1.0f);
+  for (float value : dst) {
+    std::cout << value << ' ';
+  }
+  std::cout << std::endl;
+
+  dst += fma(x, x, -y);
+  std::cout << "after +=: " << dst.front() << ' ' << dst.back() << std::endl;
+
+  // an Array operand makes eval return an Array
+  Tiny::Array<float, 3> p{3.0f, 0.0f, 4.0f};
+  Tiny::Array<float, 3> q{1.0f, 2.0f, 3.0f};
+  auto r = eval(p * q + 1.0f);
+  std::cout << "p*q+1: " << r[0] << ' ' << r[1] << ' ' << r[2] << std::endl;
+  std::cout << "dot: " << dot(p, q) << ", norm: " << norm(p)
+            << ", sum: " << sum(x) << std::endl;
+
+  try {
+    assign(dst, x + p);
+  } catch (const std::invalid_argument &e) {
+    std::cout << "Caught: " << e.what() << std::endl;
+  }
+}
+} // namespace TestExpr
+} // namespace Tiny
+
+#endif // TEST_TINY_EXPR_HPP
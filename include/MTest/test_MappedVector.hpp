@@ -0,0 +1,87 @@
+#ifndef TEST_TINY_MAPPED_VECTOR_HPP
+#define TEST_TINY_MAPPED_VECTOR_HPP
+
+#include "../MappedVector.hpp"
+#include "../Vector.hpp"
+#include <cstdio>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <unistd.h>
+
+namespace Tiny {
+namespace TestMappedVector {
+struct Record {
+  int id;
+  double score;
+};
+
+inline void test_MappedVector() {
+  const std::string path = "/tmp/tiny_test_mapped_vector_" +
+                           std::to_string(getpid()) + ".bin";
+
+  Tiny::Vector<Record> table;
+  for (int i = 0; i < 1000; i++) {
+    table.push_back(Record{i, i * 0.5});
+  }
+
+  {
+    Tiny::MappedVector<Record> out(path.c_str(), Tiny::MapMode::Append);
+    out.append(table);
+    for (int i = 1000; i < 1010; i++) {
+      out.push_back(Record{i, i * 0.5});
+    }
+    std::cout << "written: " << out.size() << std::endl;
+  }
+
+  // reopening only maps the file, nothing is read up front
+  Tiny::MappedVector<Record> in(path.c_str());
+  std::cout << "loaded: " << in.size() << ' ' << in.front().id << ' '
+            << in.back().id << ' ' << in[500].score << std::endl;
+
+  double total = 0;
+  for (const Record &record : in) {
+    total += record.score;
+  }
+  std::cout << "total score: " << total << std::endl;
+
+  try {
+    in.at(in.size());
+  } catch (const std::out_of_range &e) {
+    std::cout << "at: " << e.what() << std::endl;
+  }
+
+  // the header fingerprint rejects a file written for another type
+  try {
+    Tiny::MappedVector<long> wrong(path.c_str());
+  } catch (const std::runtime_error &e) {
+    std::cout << e.what() << std::endl;
+  }
+
+  in.close();
+  std::remove(path.c_str());
+
+  // appending elements of the vector itself while the mapping grows
+  {
+    Tiny::MappedVector<Record> self(path.c_str(), Tiny::MapMode::Append);
+    self.push_back(Record{7, 1.0});
+    for (int i = 0; i < 5000; i++) {
+      self.push_back(self[0]);
+    }
+    const std::size_t capacity = self.capacity();
+    while (self.capacity() == capacity) {
+      self.append(self.begin(), self.end());
+    }
+    double sum = 0;
+    for (const Record &record : self) {
+      sum += record.id;
+    }
+    std::cout << "self append: " << self.size() << ' '
+              << (sum == 7.0 * self.size()) << std::endl;
+  }
+  std::remove(path.c_str());
+}
+} // namespace TestMappedVector
+} // namespace Tiny
+
+#endif // TEST_TINY_MAPPED_VECTOR_HPP
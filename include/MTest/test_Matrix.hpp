@@ -0,0 +1,62 @@
+#ifndef TEST_TINY_MATRIX_HPP
+#define TEST_TINY_MATRIX_HPP
+
+#include "../Matrix.hpp"
+#include <iostream>
+
+namespace Tiny {
+namespace TestMatrix {
+template <typename M> void print_matrix(const M &m) {
+  for (std::size_t i = 0; i < m.rows(); i++) {
+    for (std::size_t j = 0; j < m.cols(); j++) {
+      std::cout << m(i, j) << ' ';
+    }
+    std::cout << std::endl;
+  }
+}
+
+inline void test_Matrix() {
+  Tiny::Matrix<float, 2, 3> m{{1, 2, 3, 4, 5, 6}};
+  print_matrix(Tiny::transpose(m));
+  std::cout << "m * I == m: "
+            << (Tiny::matmul(m, Tiny::Matrix<float, 3, 3>::identity()) == m)
+            << std::endl;
+
+  Tiny::Array<float, 3> x{1, 0, -1};
+  Tiny::Array<float, 2> y = Tiny::matvec(m, x);
+  std::cout << "m * x: " << y[0] << ' ' << y[1] << std::endl;
+
+  // big enough for the blocked kernel, with ragged edges
+  const std::size_t rows = 37, inner = 300, cols = 61;
+  Tiny::DynMatrix<double> a(rows, inner), b(inner, cols);
+  for (std::size_t i = 0; i < a.size(); i++) {
+    a.data()[i] = static_cast<double>(i % 5);
+  }
+  for (std::size_t i = 0; i < b.size(); i++) {
+    b.data()[i] = static_cast<double>(i % 3) - 1;
+  }
+  Tiny::DynMatrix<double> c = Tiny::matmul(a, b);
+  bool same = true;
+  for (std::size_t i = 0; i < rows; i++) {
+    for (std::size_t j = 0; j < cols; j++) {
+      double sum = 0;
+      for (std::size_t p = 0; p < inner; p++) {
+        sum += a(i, p) * b(p, j);
+      }
+      same = same && sum == c(i, j);
+    }
+  }
+  std::cout << "Blocked matmul matches naive: " << same << std::endl;
+  std::cout << "Transpose twice is identity: "
+            << (Tiny::transpose(Tiny::transpose(a)) == a) << std::endl;
+
+  try {
+    Tiny::matmul(a, a);
+  } catch (const std::invalid_argument &e) {
+    std::cout << "Caught: " << e.what() << std::endl;
+  }
+}
+} // namespace TestMatrix
+} // namespace Tiny
+
+#endif // TEST_TINY_MATRIX_HPP
@@ -0,0 +1,69 @@
+#ifndef TEST_TINY_PARALLEL_HPP
+#define TEST_TINY_PARALLEL_HPP
+
+#include "../Parallel.hpp"
+#include <iostream>
+
+namespace Tiny {
+namespace TestParallel {
+inline void test_Parallel() {
+  // small cutoff so the test goes through the threaded paths
+  Tiny::Parallel::Policy policy;
+  policy.threads = 4;
+  policy.cutoff = 16;
+
+  Tiny::Vector<int> vec;
+  for (int i = 0; i < 1000; i++) {
+    vec.push_back((i * 7919) % 1000);
+  }
+
+  Tiny::Parallel::sort(vec, std::less<>(), policy);
+  bool sorted = true;
+  for (std::size_t i = 1; i < vec.size(); i++) {
+    sorted = sorted && !(vec[i] < vec[i - 1]);
+  }
+  std::cout << "Parallel sort sorted: " << sorted << std::endl;
+
+  std::cout << "Parallel reduce: "
+            << Tiny::Parallel::reduce(vec, 0, std::plus<>(), policy)
+            << std::endl;
+
+  Tiny::Parallel::for_each(vec, [](int &value) { value = 1; }, policy);
+  Tiny::Vector<int> scan;
+  Tiny::Parallel::inclusive_scan(vec, scan, std::plus<>(), policy);
+  std::cout << "Parallel inclusive_scan back: " << scan.back() << std::endl;
+
+  Tiny::Vector<double> halves;
+  Tiny::Parallel::transform(
+      scan, halves, [](int value) { return value / 2.0; }, policy);
+  std::cout << "Parallel transform back: " << halves.back() << std::endl;
+
+  // more workers than elements, every chunk must still be non-empty
+  Tiny::Parallel::Policy wide;
+  wide.threads = 8;
+  wide.cutoff = 0;
+  Tiny::Vector<int> few;
+  for (int i = 1; i <= 3; i++) {
+    few.push_back(i);
+  }
+  std::cout << "Parallel reduce, 8 threads, 3 elements: "
+            << Tiny::Parallel::reduce(few, 0, std::plus<>(), wide)
+            << std::endl;
+  Tiny::Parallel::inclusive_scan(few, scan, std::plus<>(), wide);
+  std::cout << "Parallel inclusive_scan, 8 threads, 3 elements: ";
+  for (int value : scan) {
+    std::cout << value << ' ';
+  }
+  std::cout << std::endl;
+  Tiny::Parallel::for_each(few, [](int &value) { value = -value; }, wide);
+  Tiny::Parallel::sort(few, std::less<>(), wide);
+  std::cout << "Parallel sort, 8 threads, 3 elements: ";
+  for (int value : few) {
+    std::cout << value << ' ';
+  }
+  std::cout << std::endl;
+}
+} // namespace TestParallel
+} // namespace Tiny
+
+#endif // TEST_TINY_PARALLEL_HPP
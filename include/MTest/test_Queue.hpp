@@ -0,0 +1,174 @@
+#ifndef TEST_TINY_QUEUE_HPP
+#define TEST_TINY_QUEUE_HPP
+
+#include "../Queue.hpp"
+#include <algorithm>
+#include <functional>
+#include <iostream>
+#include <string>
+
+namespace Tiny {
+namespace TestQueue {
+// stateful allocator that counts live allocations per arena and never
+// propagates, so a Deque keeps its arena when moved into
+template <typename T> struct ArenaAllocator {
+  using value_type = T;
+
+  int id;
+  int *live;
+
+  ArenaAllocator(int id, int *live) : id(id), live(live) {}
+  template <typename U>
+  ArenaAllocator(const ArenaAllocator<U> &other)
+      : id(other.id), live(other.live) {}
+
+  T *allocate(std::size_t n) {
+    ++*live;
+    return static_cast<T *>(::operator new(n * sizeof(T)));
+  }
+
+  void deallocate(T *ptr, std::size_t) {
+    --*live;
+    ::operator delete(ptr);
+  }
+
+  template <typename U>
+  friend bool operator==(const ArenaAllocator &lhs,
+                         const ArenaAllocator<U> &rhs) {
+    return lhs.id == rhs.id;
+  }
+};
+
+template <typename T, typename Alloc>
+void print_deque(const Tiny::Deque<T, Alloc> &deque) {
+  for (const T &value : deque) {
+    std::cout << value << ' ';
+  }
+  std::cout << "(size: " << deque.size() << ")" << std::endl;
+}
+
+inline void test_Deque() {
+  Tiny::Deque<std::string> words;
+  words.push_back("b");
+  words.push_back("c");
+  words.push_front("a");
+  words.emplace_front(2, 'z');
+  print_deque(words);
+  words.pop_front();
+  words.pop_back();
+  std::cout << "front: " << words.front() << ", back: " << words.back()
+            << ", [1]: " << words[1] << std::endl;
+
+  // far more pushes than one block holds, at both ends
+  Tiny::Deque<int> numbers;
+  for (int i = 0; i < 1000; i++) {
+    numbers.push_back(i);
+    numbers.push_front(-i - 1);
+  }
+  std::cout << "size: " << numbers.size() << ", front: " << numbers.front()
+            << ", back: " << numbers.back() << ", [1000]: " << numbers[1000]
+            << std::endl;
+
+  // a sliding window keeps reusing the same blocks
+  for (int i = 0; i < 100000; i++) {
+    numbers.push_back(i);
+    numbers.pop_front();
+  }
+  std::cout << "after sliding, front: " << numbers.front()
+            << ", back: " << numbers.back() << std::endl;
+
+  std::sort(numbers.begin(), numbers.end());
+  Tiny::Deque<int> copy = numbers;
+  std::cout << "sorted copy front: " << copy.front()
+            << ", is sorted: " << std::is_sorted(copy.begin(), copy.end())
+            << std::endl;
+
+  try {
+    copy.at(copy.size());
+  } catch (const std::out_of_range &e) {
+    std::cout << "Caught: " << e.what() << std::endl;
+  }
+
+  // the map and the blocks both come from the arena
+  int live_a = 0, live_b = 0;
+  using Alloc = ArenaAllocator<int>;
+  {
+    Tiny::Deque<int, Alloc> in_a(Alloc(1, &live_a));
+    Tiny::Deque<int, Alloc> in_b(Alloc(2, &live_b));
+    for (int i = 0; i < 3; i++) {
+      in_a.push_back(i);
+      in_b.push_front(10 + i);
+    }
+    std::cout << "Arena a/b live blocks: " << live_a << '/' << live_b
+              << std::endl;
+
+    // the allocators differ and do not propagate, so elements move over
+    in_a = std::move(in_b);
+    print_deque(in_a);
+    std::cout << "After move, allocator id: " << in_a.get_allocator().id
+              << ", arena b live blocks: " << live_b << std::endl;
+  }
+  std::cout << "At exit, arena a/b live blocks: " << live_a << '/' << live_b
+            << std::endl;
+}
+
+inline void test_Priority_Queue() {
+  // smallest first by default
+  Tiny::Priority_Queue<int> numbers;
+  for (int value : {5, 1, 8, 3, 9, 2}) {
+    numbers.push(value);
+  }
+  std::cout << "top: " << numbers.top()
+            << ", push_pop(0): " << numbers.push_pop(0)
+            << ", replace_top(7): " << numbers.replace_top(7) << ", order: ";
+  while (!numbers.empty()) {
+    std::cout << numbers.top() << ' ';
+    numbers.pop();
+  }
+  std::cout << std::endl;
+
+  // built in O(n) from a Vector, largest first, binary
+  Tiny::Vector<std::string> words;
+  for (const char *word : {"pear", "fig", "apple", "kiwi", "plum"}) {
+    words.push_back(word);
+  }
+  Tiny::Priority_Queue<std::string, std::greater<std::string>, 2> by_name(
+      std::move(words));
+  by_name.emplace(3, 'z');
+  std::cout << "size: " << by_name.size() << ", order: ";
+  while (!by_name.empty()) {
+    std::cout << by_name.top() << ' ';
+    by_name.pop();
+  }
+  std::cout << std::endl;
+}
+
+inline void test_Indexed_Priority_Queue() {
+  // tasks 0..4 by deadline, rescheduled while queued
+  Tiny::Indexed_Priority_Queue<int> tasks;
+  const int deadlines[] = {40, 10, 30, 50, 20};
+  for (std::size_t task = 0; task < 5; task++) {
+    tasks.push(task, deadlines[task]);
+  }
+  tasks.decrease_key(3, 5);
+  tasks.increase_key(1, 45);
+  tasks.erase(2);
+  tasks.update(0, 15);
+  std::cout << "contains 2: " << tasks.contains(2)
+            << ", key of 4: " << tasks.key(4) << ", order: ";
+  while (!tasks.empty()) {
+    std::cout << tasks.top() << '@' << tasks.top_key() << ' ';
+    tasks.pop();
+  }
+  std::cout << std::endl;
+
+  try {
+    tasks.decrease_key(2, 0);
+  } catch (const std::out_of_range &e) {
+    std::cout << "Caught: " << e.what() << std::endl;
+  }
+}
+} // namespace TestQueue
+} // namespace Tiny
+
+#endif // TEST_TINY_QUEUE_HPP
@@ -0,0 +1,66 @@
+#ifndef TEST_TINY_RING_BUFFER_HPP
+#define TEST_TINY_RING_BUFFER_HPP
+
+#include "../Queue.hpp"
+#include "../RingBuffer.hpp"
+#include <iostream>
+#include <string>
+
+namespace Tiny {
+namespace TestRingBuffer {
+template <typename R> void print_ring(const R &ring) {
+  for (std::size_t i = 0; i < ring.size(); i++) {
+    std::cout << ring[i] << ' ';
+  }
+  std::cout << "(size: " << ring.size() << ", capacity: " << ring.capacity()
+            << ")" << std::endl;
+}
+
+inline void test_RingBuffer() {
+  // the last four readings, older ones fall out
+  Tiny::RingBuffer<int, 4, Tiny::RingPolicy::Overwrite> recent;
+  for (int i = 1; i <= 6; i++) {
+    recent.push_back(i * 10);
+  }
+  print_ring(recent);
+
+  // a bounded buffer refuses what does not fit
+  Tiny::RingBuffer<int> bounded(3);
+  int input[] = {1, 2, 3, 4, 5, 6};
+  std::cout << "Stored " << bounded.push_n(input) << " of 6, push_back: "
+            << bounded.push_back(7) << std::endl;
+  print_ring(bounded);
+  int output[3];
+  std::cout << "Popped " << bounded.pop_n(output) << ": " << output[0] << ' '
+            << output[1] << ' ' << output[2] << std::endl;
+
+  // a growing buffer doubles like a Vector
+  Tiny::RingBuffer<std::string, 0, Tiny::RingPolicy::Grow> names;
+  names.push_back("a");
+  names.push_back("b");
+  names.pop_front();
+  names.push_back("c");
+  names.push_back("d");
+  names.back() += "!";
+  print_ring(names);
+
+  // Queue on a RingBuffer: O(1) back(), no allocation per push
+  Tiny::Queue<std::string, Tiny::RingBuffer<std::string, 0,
+                                            Tiny::RingPolicy::Grow>>
+      queue;
+  queue.push("first");
+  queue.push("second");
+  queue.front() += "!";
+  std::cout << "Queue front: " << queue.front() << ", back: " << queue.back()
+            << std::endl;
+
+  try {
+    bounded.at(5);
+  } catch (const std::out_of_range &e) {
+    std::cout << "Caught: " << e.what() << std::endl;
+  }
+}
+} // namespace TestRingBuffer
+} // namespace Tiny
+
+#endif // TEST_TINY_RING_BUFFER_HPP
@@ -0,0 +1,36 @@
+#ifndef TEST_TINY_SIMD_HPP
+#define TEST_TINY_SIMD_HPP
+
+#include "../Array.hpp"
+#include "../Simd.hpp"
+#include "../Vector.hpp"
+#include <iostream>
+
+namespace Tiny {
+namespace TestSimd {
+inline void test_Simd() {
+  Tiny::Vector<int> vec;
+  for (int i = 0; i < 100; i++) {
+    vec.push_back((i * 37) % 101 - 50);
+  }
+
+  std::cout << "find 7: " << Tiny::Simd::find(vec, 7) << std::endl;
+  std::cout << "count 7: " << Tiny::Simd::count(vec, 7) << std::endl;
+  std::cout << "contains 1000: " << Tiny::Simd::contains(vec, 1000)
+            << std::endl;
+  std::cout << "sum: " << Tiny::Simd::sum(vec) << std::endl;
+  std::cout << "min: " << Tiny::Simd::min(vec) << std::endl;
+  std::cout << "max: " << Tiny::Simd::max(vec) << std::endl;
+
+  Tiny::Array<float, 5> arr;
+  for (std::size_t i = 0; i < arr.size(); i++) {
+    arr[i] = 1.5f * i - 2.0f;
+  }
+  auto [lo, hi] = Tiny::Simd::minmax(arr);
+  std::cout << "Array minmax: " << lo << ' ' << hi << std::endl;
+  std::cout << "Array sum: " << Tiny::Simd::sum(arr) << std::endl;
+}
+} // namespace TestSimd
+} // namespace Tiny
+
+#endif // TEST_TINY_SIMD_HPP
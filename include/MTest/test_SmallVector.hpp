@@ -0,0 +1,96 @@
+#ifndef TEST_TINY_SMALL_VECTOR_HPP
+#define TEST_TINY_SMALL_VECTOR_HPP
+
+#include "../SmallVector.hpp"
+#include "../Stack.hpp"
+#include <iostream>
+#include <string>
+
+namespace Tiny {
+namespace TestSmallVector {
+template <typename T, std::size_t N>
+void print_small_vector(const Tiny::SmallVector<T, N> &vec) {
+  for (std::size_t i = 0; i < vec.size(); i++) {
+    std::cout << vec[i] << ' ';
+  }
+  std::cout << "(inline: " << vec.is_inline()
+            << ", capacity: " << vec.capacity() << ')' << std::endl;
+}
+
+inline void test_SmallVector() {
+  Tiny::SmallVector<int, 4> vec;
+  for (int i = 0; i < 4; i++) {
+    vec.push_back(i);
+  }
+  print_small_vector(vec);
+
+  vec.push_back(4);
+  print_small_vector(vec);
+
+  Tiny::SmallVector<int, 4> vec2 = vec;
+  Tiny::SmallVector<int, 4> vec3 = std::move(vec);
+  print_small_vector(vec2);
+  print_small_vector(vec3);
+  print_small_vector(vec);
+
+  // a heap buffer moves into a Vector and back without copying
+  const int *buffer = vec3.data();
+  Tiny::Vector<int> as_vector = std::move(vec3).to_vector();
+  std::cout << "Vector took buffer: " << (as_vector.data() == buffer)
+            << std::endl;
+  Tiny::SmallVector<int, 4> back(std::move(as_vector));
+  std::cout << "SmallVector took buffer: " << (back.data() == buffer)
+            << std::endl;
+  Tiny::Vector<int, Tiny::Allocator<int>, Tiny::GrowHalf> halves =
+      std::move(back).to_vector<Tiny::GrowHalf>();
+  Tiny::SmallVector<int, 4> from_halves(std::move(halves));
+  std::cout << "SmallVector took GrowHalf buffer: "
+            << (from_halves.data() == buffer) << std::endl;
+
+  Tiny::SmallVector<std::string, 2> strs;
+  strs.emplace_back("small");
+  strs.emplace_back(3, 'x');
+  strs.emplace_back("spilled");
+  print_small_vector(strs);
+  strs.clear();
+  print_small_vector(strs);
+
+  // pushing an element of a full vector must not read the freed buffer
+  Tiny::SmallVector<std::string, 2> alias;
+  alias.push_back("first element, long enough to live on the heap");
+  alias.push_back("second");
+  alias.push_back(alias[0]);
+  alias.push_back(alias[1]);
+  alias.emplace_back(std::move(alias[0]));
+  print_small_vector(alias);
+
+  Tiny::SmallVector<std::string, 4> edit;
+  edit.push_back("b");
+  edit.insert(edit.begin(), "a");
+  edit.emplace(edit.end(), "d");
+  edit.emplace(edit.begin() + 2, "c");
+  edit.insert(edit.begin() + 1, 2, edit[3]);
+  print_small_vector(edit);
+  const std::string more[] = {"x", "y"};
+  edit.insert(edit.end(), more, more + 2);
+  edit.erase(edit.begin() + 1, edit.begin() + 3);
+  edit.erase(edit.begin());
+  print_small_vector(edit);
+  edit.shrink_to_fit();
+  print_small_vector(edit);
+  edit.pop_back();
+  edit.pop_back();
+  edit.shrink_to_fit();
+  print_small_vector(edit);
+
+  Tiny::Stack<int, Tiny::SmallVector<int, 8>> stack;
+  for (int i = 0; i < 5; i++) {
+    stack.push(i);
+  }
+  std::cout << "Stack top: " << stack.top() << ", size: " << stack.size()
+            << std::endl;
+}
+} // namespace TestSmallVector
+} // namespace Tiny
+
+#endif // TEST_TINY_SMALL_VECTOR_HPP
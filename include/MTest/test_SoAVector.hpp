@@ -0,0 +1,45 @@
+#ifndef TEST_TINY_SOA_VECTOR_HPP
+#define TEST_TINY_SOA_VECTOR_HPP
+
+#include "../SoAVector.hpp"
+#include <cstdint>
+#include <iostream>
+#include <string>
+
+namespace Tiny {
+namespace TestSoAVector {
+inline void test_SoAVector() {
+  Tiny::SoAVector<int, std::string, double> table;
+  for (int i = 0; i < 100; i++) {
+    table.emplace_back(i, "row" + std::to_string(i), i * 0.5);
+  }
+  table.push_back({100, "last", 50.0});
+
+  auto [id, name, score] = table[42];
+  std::cout << "Row 42: " << id << ' ' << name << ' ' << score << std::endl;
+
+  // rows are references, writing through them updates the columns
+  std::get<2>(table.back()) = 99.5;
+
+  double total = 0;
+  for (double value : table.column<2>()) {
+    total += value;
+  }
+  std::cout << "Size: " << table.size() << ", score total: " << total
+            << std::endl;
+
+  bool aligned =
+      reinterpret_cast<std::uintptr_t>(table.data<0>()) % 64 == 0 &&
+      reinterpret_cast<std::uintptr_t>(table.data<1>()) % 64 == 0 &&
+      reinterpret_cast<std::uintptr_t>(table.data<2>()) % 64 == 0;
+  std::cout << "Columns aligned to 64: " << aligned << std::endl;
+
+  Tiny::SoAVector<int, std::string, double> copy = table;
+  copy.resize(3);
+  std::cout << "Copy back: " << std::get<1>(copy.back())
+            << ", original back: " << std::get<1>(table.back()) << std::endl;
+}
+} // namespace TestSoAVector
+} // namespace Tiny
+
+#endif // TEST_TINY_SOA_VECTOR_HPP
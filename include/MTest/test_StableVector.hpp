@@ -0,0 +1,54 @@
+#ifndef TEST_TINY_STABLE_VECTOR_HPP
+#define TEST_TINY_STABLE_VECTOR_HPP
+
+#include "../StableVector.hpp"
+#include <algorithm>
+#include <iostream>
+#include <string>
+
+namespace Tiny {
+namespace TestStableVector {
+inline void test_StableVector() {
+  Tiny::StableVector<std::string> vec;
+  vec.push_back("first");
+  const std::string *first = &vec.front();
+
+  // growing adds blocks, the first element never moves
+  for (int i = 1; i < 1000; i++) {
+    vec.emplace_back(std::to_string(i));
+  }
+  std::cout << "Size: " << vec.size() << ", capacity: " << vec.capacity()
+            << ", first still at " << (first == &vec[0] ? "same" : "new")
+            << " address: " << *first << std::endl;
+  std::cout << "vec[500]: " << vec[500] << ", back: " << vec.back()
+            << std::endl;
+
+  Tiny::StableVector<int> nums;
+  for (int i = 0; i < 40; i++) {
+    nums.push_back((i * 7) % 40);
+  }
+  std::sort(nums.begin(), nums.end());
+  for (int value : nums) {
+    std::cout << value << ' ';
+  }
+  std::cout << std::endl;
+
+  std::size_t blocks = 0;
+  nums.for_each_block([&](const int *, std::size_t) { ++blocks; });
+  std::cout << "Blocks in use: " << blocks << std::endl;
+
+  nums.resize(5);
+  nums.shrink_to_fit();
+  std::cout << "After shrink_to_fit capacity: " << nums.capacity()
+            << std::endl;
+
+  try {
+    nums.at(5);
+  } catch (const std::out_of_range &e) {
+    std::cout << "at: " << e.what() << std::endl;
+  }
+}
+} // namespace TestStableVector
+} // namespace Tiny
+
+#endif // TEST_TINY_STABLE_VECTOR_HPP
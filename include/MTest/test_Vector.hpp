@@ -1,11 +1,239 @@
 #ifndef TEST_TINY_VECTOR_HPP
 #define TEST_TINY_VECTOR_HPP
 
+#include "../MmapAllocator.hpp"
 #include "../Vector.hpp"
+#include <cstdint>
 #include <iostream>
+#include <string>
+#include <type_traits>
 
 namespace Tiny {
 namespace TestVector {
+// stateful allocator that counts live allocations per arena id
+template <typename T> struct CountingAllocator {
+  using value_type = T;
+  using propagate_on_container_move_assignment = std::true_type;
+  using propagate_on_container_swap = std::true_type;
+
+  int id;
+  int *live;
+
+  CountingAllocator(int id, int *live) : id(id), live(live) {}
+  template <typename U>
+  CountingAllocator(const CountingAllocator<U> &other)
+      : id(other.id), live(other.live) {}
+
+  T *allocate(std::size_t n) {
+    ++*live;
+    return static_cast<T *>(::operator new(n * sizeof(T)));
+  }
+
+  void deallocate(T *ptr, std::size_t) {
+    --*live;
+    ::operator delete(ptr);
+  }
+
+  friend bool operator==(const CountingAllocator &lhs,
+                         const CountingAllocator &rhs) {
+    return lhs.id == rhs.id;
+  }
+};
+
+inline void test_Vector_allocator() {
+  int live_a = 0, live_b = 0;
+  using Alloc = CountingAllocator<int>;
+
+  {
+    Tiny::Vector<int, Alloc> vec_a(Alloc(1, &live_a));
+    for (int i = 0; i < 10; i++) {
+      vec_a.push_back(i);
+    }
+    std::cout << "Arena a live blocks: " << live_a << std::endl;
+
+    Tiny::Vector<int, Alloc> vec_b(4, 7, Alloc(2, &live_b));
+    std::cout << "Arena b live blocks: " << live_b << std::endl;
+
+    // move assignment propagates the allocator together with the buffer
+    vec_b = std::move(vec_a);
+    std::cout << "After move, arena a/b live blocks: " << live_a << '/'
+              << live_b << std::endl;
+    std::cout << "vec_b allocator id: " << vec_b.get_allocator().id
+              << std::endl;
+
+    // copy assignment does not propagate, the copy lives in arena b
+    Tiny::Vector<int, Alloc> vec_c(Alloc(2, &live_b));
+    vec_c = vec_b;
+    std::cout << "After copy, arena a/b live blocks: " << live_a << '/'
+              << live_b << std::endl;
+
+    vec_b.swap(vec_c);
+    std::cout << "After swap, vec_b allocator id: "
+              << vec_b.get_allocator().id << std::endl;
+  }
+
+  std::cout << "At exit, arena a/b live blocks: " << live_a << '/' << live_b
+            << std::endl;
+}
+
+// no default constructor, only buildable from an int
+struct NoDefault {
+  explicit NoDefault(int value) : value(value) {}
+  int value;
+};
+
+// move constructor may throw, so growth has to copy to stay safe
+struct ThrowingMove {
+  static inline int copies = 0;
+  static inline int moves = 0;
+
+  ThrowingMove() = default;
+  ThrowingMove(const ThrowingMove &) { ++copies; }
+  ThrowingMove(ThrowingMove &&) noexcept(false) { ++moves; }
+};
+
+inline void test_Vector_relocate() {
+  Tiny::Vector<NoDefault> vec;
+  for (int i = 0; i < 5; i++) {
+    vec.emplace_back(i * 10);
+  }
+  std::cout << "NoDefault back: " << vec.back().value << std::endl;
+
+  Tiny::Vector<ThrowingMove> vec2;
+  for (int i = 0; i < 8; i++) {
+    vec2.emplace_back();
+  }
+  std::cout << "ThrowingMove copies/moves on growth: " << ThrowingMove::copies
+            << '/' << ThrowingMove::moves << std::endl;
+
+  Tiny::Vector<long> vec3;
+  for (long i = 0; i < 1000; i++) {
+    vec3.push_back(i);
+  }
+  std::cout << "Trivially relocatable sum: "
+            << vec3[0] + vec3[500] + vec3[999] << std::endl;
+}
+
+template <typename T, typename Alloc>
+void print_vector(const Tiny::Vector<T, Alloc> &vec) {
+  for (const T &value : vec) {
+    std::cout << value << ' ';
+  }
+  std::cout << "(size: " << vec.size() << ')' << std::endl;
+}
+
+inline void test_Vector_insert() {
+  Tiny::Vector<int> vec;
+  for (int i = 0; i < 6; i++) {
+    vec.push_back(i);
+  }
+
+  int extra[] = {100, 101, 102};
+  vec.insert(vec.begin() + 2, extra, extra + 3);
+  print_vector(vec);
+
+  vec.erase(vec.begin() + 1, vec.begin() + 4);
+  print_vector(vec);
+
+  vec.insert(vec.end(), 3, -1);
+  vec.emplace(vec.begin(), vec.back());
+  print_vector(vec);
+
+  vec.erase(vec.begin());
+  print_vector(vec);
+
+  Tiny::Vector<std::string> strs;
+  strs.emplace_back("b");
+  strs.emplace_back("d");
+  strs.emplace(strs.begin(), "a");
+  strs.insert(strs.begin() + 2, std::string("c"));
+  std::string more[] = {"e", "f"};
+  strs.insert(strs.end(), more, more + 2);
+  print_vector(strs);
+
+  strs.erase(strs.begin() + 1, strs.end() - 1);
+  print_vector(strs);
+}
+
+inline void test_Vector_mmap() {
+  // a small threshold so the test crosses into mapped storage quickly
+  using Alloc = Tiny::MmapAllocator<std::uint64_t, 4096, true>;
+  Tiny::Vector<std::uint64_t, Alloc> vec;
+
+  std::uint64_t sum = 0;
+  for (std::uint64_t i = 0; i < 1000000; i++) {
+    vec.push_back(i);
+    sum += i;
+  }
+
+  std::uint64_t check = 0;
+  for (std::uint64_t value : vec) {
+    check += value;
+  }
+  std::cout << "Mapped vector size: " << vec.size()
+            << ", sum matches: " << (sum == check) << std::endl;
+
+  vec.resize(1000);
+  vec.shrink_to_fit();
+  std::cout << "After shrink_to_fit capacity: " << vec.capacity()
+            << ", back: " << vec.back() << std::endl;
+}
+
+inline void test_Vector_aligned() {
+  using Vec = Tiny::AlignedVector<float, 32>;
+  static_assert(Vec::alignment == 32);
+
+  Vec vec;
+  for (int i = 0; i < 13; i++) {
+    vec.push_back(i * 0.5f);
+  }
+  std::cout << "Aligned to 32: "
+            << (reinterpret_cast<std::uintptr_t>(vec.data()) % 32 == 0)
+            << ", capacity: " << vec.capacity() << std::endl;
+
+  Vec vec2 = vec;
+  vec2.shrink_to_fit();
+  std::cout << "Copy aligned to 32: "
+            << (reinterpret_cast<std::uintptr_t>(vec2.data()) % 32 == 0)
+            << ", padded capacity: " << vec2.capacity() << std::endl;
+}
+
+template <typename Policy> void print_growth(const char *name) {
+  Tiny::Vector<int, Tiny::Allocator<int>, Policy> vec;
+  std::size_t capacity = vec.capacity();
+  std::cout << name << " capacities:";
+  for (int i = 0; i < 100; i++) {
+    vec.push_back(i);
+    if (vec.capacity() != capacity) {
+      capacity = vec.capacity();
+      std::cout << ' ' << capacity;
+    }
+  }
+  std::cout << std::endl;
+}
+
+inline void test_Vector_growth() {
+  print_growth<Tiny::GrowDouble>("GrowDouble");
+  print_growth<Tiny::GrowHalf>("GrowHalf");
+  print_growth<Tiny::GrowChunk<32>>("GrowChunk<32>");
+
+  // stats compile away unless TINY_VECTOR_STATS is defined
+#ifndef TINY_VECTOR_STATS
+  static_assert(sizeof(Tiny::Vector<int>) == 3 * sizeof(void *));
+#endif
+  Tiny::reset_vector_stats();
+  Tiny::Vector<std::string> vec;
+  for (int i = 0; i < 100; i++) {
+    vec.emplace_back(i, 'x');
+  }
+  Tiny::VectorStats stats = vec.stats();
+  Tiny::VectorStats global = Tiny::vector_stats();
+  std::cout << "Stats reallocations: " << stats.reallocations
+            << ", moved: " << stats.moved << ", copied: " << stats.copied
+            << ", peak capacity: " << stats.peak_capacity
+            << ", global moved: " << global.moved << std::endl;
+}
+
 inline void test_Vector() {
   Tiny::Vector<int> vec;
 
@@ -0,0 +1,281 @@
+#ifndef TINY_MAPPED_VECTOR_HPP
+#define TINY_MAPPED_VECTOR_HPP
+
+#include "Vector.hpp"
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fcntl.h>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <system_error>
+#include <type_traits>
+#include <typeinfo>
+#include <unistd.h>
+#include <utility>
+
+namespace Tiny {
+enum class MapMode {
+  Read,  // map an existing file read-only
+  Append // map read-write, creating the file if needed, and allow appends
+};
+
+// Vector-like read access to a table of trivially copyable T stored in a
+// file and mapped with MAP_SHARED, so opening it costs O(1) however large
+// the table is.
+// File layout: a 64 byte header (magic, type fingerprint, element count)
+// followed by the elements. In Append mode the file grows geometrically
+// with ftruncate + mremap and is trimmed to the used size on close.
+template <typename T> class MappedVector {
+  static_assert(std::is_trivially_copyable_v<T>,
+                "MappedVector only holds trivially copyable types.");
+  static_assert(alignof(T) <= 64, "MappedVector element alignment too big.");
+
+public:
+  using iterator = const T *;
+  using const_iterator = const T *;
+
+  MappedVector(const char *path, MapMode mode = MapMode::Read);
+
+  MappedVector(const MappedVector &) = delete;
+  MappedVector &operator=(const MappedVector &) = delete;
+
+  MappedVector(MappedVector &&other) noexcept
+      : fd_(std::exchange(other.fd_, -1)), mode_(other.mode_),
+        map_(std::exchange(other.map_, nullptr)),
+        map_bytes_(std::exchange(other.map_bytes_, 0)),
+        capacity_(std::exchange(other.capacity_, 0)) {}
+
+  MappedVector &operator=(MappedVector &&other) noexcept {
+    if (this != &other) {
+      close();
+      fd_ = std::exchange(other.fd_, -1);
+      mode_ = other.mode_;
+      map_ = std::exchange(other.map_, nullptr);
+      map_bytes_ = std::exchange(other.map_bytes_, 0);
+      capacity_ = std::exchange(other.capacity_, 0);
+    }
+    return *this;
+  }
+
+  ~MappedVector() { close(); }
+
+  // Element access
+  const T &operator[](std::size_t index) const { return data()[index]; }
+
+  const T &at(std::size_t index) const {
+    if (index >= size()) {
+      throw std::out_of_range("Index out of range");
+    }
+    return data()[index];
+  }
+
+  const T &front() const { return data()[0]; }
+  const T &back() const { return data()[size() - 1]; }
+
+  const T *data() const {
+    return reinterpret_cast<const T *>(map_ + data_offset);
+  }
+
+  const_iterator begin() const { return data(); }
+  const_iterator end() const { return data() + size(); }
+
+  // Capacity
+  std::size_t size() const {
+    return map_ == nullptr ? 0 : _header()->size;
+  }
+  std::size_t capacity() const { return capacity_; }
+  bool empty() const { return size() == 0; }
+  bool is_open() const { return map_ != nullptr; }
+
+  // Modifiers, Append mode only
+  void push_back(const T &value) { append(&value, &value + 1); }
+
+  void append(const T *first, const T *last) {
+    _check_append();
+    const std::size_t count = last - first;
+    const std::size_t size = _header()->size;
+    if (size + count > capacity_) {
+      // reserve may move the mapping, so a source inside it is kept as an
+      // offset and found again afterwards
+      const std::uintptr_t begin = reinterpret_cast<std::uintptr_t>(data());
+      const std::uintptr_t from = reinterpret_cast<std::uintptr_t>(first);
+      const bool inside = from >= begin && from < begin + size * sizeof(T);
+      const std::size_t offset = (from - begin) / sizeof(T);
+      reserve(size + count > capacity_ * 2 ? size + count : capacity_ * 2);
+      if (inside) {
+        first = data() + offset;
+      }
+    }
+    if (count != 0) {
+      std::memcpy(map_ + data_offset + size * sizeof(T), first,
+                  count * sizeof(T));
+    }
+    // the count is published after the elements are in place
+    _header()->size = size + count;
+  }
+
+  // snapshot a whole Vector in one copy
+  template <typename Alloc, typename Grow>
+  void append(const Vector<T, Alloc, Grow> &vec) {
+    append(vec.data(), vec.data() + vec.size());
+  }
+
+  // grow the file and the mapping to hold capacity elements
+  void reserve(std::size_t capacity) {
+    _check_append();
+    if (capacity <= capacity_) {
+      return;
+    }
+    const std::size_t bytes = data_offset + capacity * sizeof(T);
+    if (ftruncate(fd_, static_cast<off_t>(bytes)) != 0) {
+      throw std::system_error(errno, std::generic_category());
+    }
+    void *map = mremap(map_, map_bytes_, bytes, MREMAP_MAYMOVE);
+    if (map == MAP_FAILED) {
+      throw std::system_error(errno, std::generic_category());
+    }
+    map_ = static_cast<unsigned char *>(map);
+    map_bytes_ = bytes;
+    capacity_ = capacity;
+  }
+
+  // flush written pages to the file
+  void sync() {
+    if (map_ != nullptr && msync(map_, map_bytes_, MS_SYNC) != 0) {
+      throw std::system_error(errno, std::generic_category());
+    }
+  }
+
+  // unmap and close; in Append mode the file is trimmed to its used size
+  void close() noexcept {
+    if (map_ != nullptr) {
+      const std::size_t used = data_offset + _header()->size * sizeof(T);
+      munmap(map_, map_bytes_);
+      if (mode_ == MapMode::Append) {
+        (void)ftruncate(fd_, static_cast<off_t>(used));
+      }
+      map_ = nullptr;
+      map_bytes_ = 0;
+      capacity_ = 0;
+    }
+    if (fd_ != -1) {
+      ::close(fd_);
+      fd_ = -1;
+    }
+  }
+
+  // identifies the element layout, a file written for another type or
+  // build with a different layout is rejected on open
+  static std::uint64_t fingerprint() {
+    // FNV-1a over the mangled type name and the layout
+    std::uint64_t hash = 14695981039346656037ull;
+    auto mix = [&hash](std::uint64_t byte) {
+      hash ^= byte;
+      hash *= 1099511628211ull;
+    };
+    for (const char *name = typeid(T).name(); *name != '\0'; ++name) {
+      mix(static_cast<unsigned char>(*name));
+    }
+    mix(sizeof(T));
+    mix(alignof(T));
+    return hash;
+  }
+
+private:
+  struct Header {
+    char magic[8];
+    std::uint64_t fingerprint;
+    std::uint64_t size;
+  };
+
+  static constexpr std::size_t data_offset = 64;
+  static constexpr char magic[8] = {'T', 'I', 'N', 'Y', 'M', 'V', 'E', 'C'};
+
+  Header *_header() { return reinterpret_cast<Header *>(map_); }
+  const Header *_header() const {
+    return reinterpret_cast<const Header *>(map_);
+  }
+
+  void _check_append() const {
+    if (mode_ != MapMode::Append) {
+      throw std::logic_error("MappedVector is not open for appending");
+    }
+  }
+
+  void _fail(int error) {
+    close();
+    throw std::system_error(error, std::generic_category());
+  }
+
+  int fd_;
+  MapMode mode_;
+  unsigned char *map_;
+  std::size_t map_bytes_;
+  std::size_t capacity_;
+};
+} // namespace Tiny
+
+template <typename T>
+Tiny::MappedVector<T>::MappedVector(const char *path, MapMode mode)
+    : fd_(-1), mode_(mode), map_(nullptr), map_bytes_(0), capacity_(0) {
+  const bool append = mode == MapMode::Append;
+  fd_ = ::open(path, append ? O_RDWR | O_CREAT : O_RDONLY, 0644);
+  if (fd_ == -1) {
+    _fail(errno);
+  }
+
+  struct stat st;
+  if (fstat(fd_, &st) != 0) {
+    _fail(errno);
+  }
+  std::size_t bytes = static_cast<std::size_t>(st.st_size);
+
+  // a new file starts with just the header
+  const bool fresh = append && bytes == 0;
+  if (fresh) {
+    bytes = data_offset;
+    if (ftruncate(fd_, static_cast<off_t>(bytes)) != 0) {
+      _fail(errno);
+    }
+  }
+  if (bytes < data_offset) {
+    close();
+    throw std::runtime_error("MappedVector: file too small for a header");
+  }
+
+  const int prot = append ? PROT_READ | PROT_WRITE : PROT_READ;
+  void *map = mmap(nullptr, bytes, prot, MAP_SHARED, fd_, 0);
+  if (map == MAP_FAILED) {
+    _fail(errno);
+  }
+  map_ = static_cast<unsigned char *>(map);
+  map_bytes_ = bytes;
+  capacity_ = (bytes - data_offset) / sizeof(T);
+
+  if (fresh) {
+    Header *header = _header();
+    std::memcpy(header->magic, magic, sizeof(magic));
+    header->fingerprint = fingerprint();
+    header->size = 0;
+    return;
+  }
+
+  const Header *header = _header();
+  if (std::memcmp(header->magic, magic, sizeof(magic)) != 0) {
+    close();
+    throw std::runtime_error("MappedVector: not a MappedVector file");
+  }
+  if (header->fingerprint != fingerprint()) {
+    close();
+    throw std::runtime_error("MappedVector: element type mismatch");
+  }
+  if (header->size > capacity_) {
+    close();
+    throw std::runtime_error("MappedVector: file is truncated");
+  }
+}
+
+#endif // TINY_MAPPED_VECTOR_HPP
@@ -0,0 +1,426 @@
+#ifndef TINY_MATRIX_HPP
+#define TINY_MATRIX_HPP
+
+#include "Array.hpp"
+#include "Simd.hpp"
+#include "Vector.hpp"
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+
+// Row-major matrices: Matrix<T, R, C> sits on an Array<T, R * C>, DynMatrix
+// on a Vector<T>. Both share the kernels below, which work on plain
+// row-major buffers:
+//   transpose  copies in square tiles so reads and writes both stay within
+//              a few cache lines
+//   matmul     packs panels of B, then a register-tiled microkernel keeps a
+//              4 x 3 block of vectors of C in registers across the whole
+//              panel; built for SSE2 and AVX2 like the Simd kernels
+//   matvec     one vectorized dot product per row
+namespace Tiny {
+namespace Impl {
+// ==== Matrix Kernels Begin Here ====
+inline constexpr std::size_t transpose_tile = 16;
+
+// dst (cols x rows) = src (rows x cols)^T
+template <typename T>
+void transpose(const T *src, T *dst, std::size_t rows, std::size_t cols) {
+  for (std::size_t ib = 0; ib < rows; ib += transpose_tile) {
+    const std::size_t ie =
+        ib + transpose_tile < rows ? ib + transpose_tile : rows;
+    for (std::size_t jb = 0; jb < cols; jb += transpose_tile) {
+      const std::size_t je =
+          jb + transpose_tile < cols ? jb + transpose_tile : cols;
+      for (std::size_t i = ib; i < ie; ++i) {
+        for (std::size_t j = jb; j < je; ++j) {
+          dst[j * rows + i] = src[i * cols + j];
+        }
+      }
+    }
+  }
+}
+
+struct MatMul {
+  // register tile: mr rows by nv vectors of C, 12 accumulators plus the B
+  // row and the broadcast A value fit the 16 vector registers of SSE2/AVX2
+  static constexpr std::size_t mr = 4;
+  static constexpr std::size_t nv = 3;
+  // B is packed kc rows by nc columns at a time, small enough for L2
+  static constexpr std::size_t kc = 256;
+  static constexpr std::size_t nc = 192;
+
+  // widest column strip, sizes the packing buffer for every kernel width
+  template <typename T> static constexpr std::size_t max_nr() {
+    return nv * 32 / sizeof(T);
+  }
+
+  template <typename T> static constexpr std::size_t pack_size() {
+    return kc * ((nc + max_nr<T>() - 1) / max_nr<T>() * max_nr<T>());
+  }
+
+  // c (m x n) += a (m x kc) * packed strip (kc x nr), the a rows are lda
+  // apart; rows past m repeat the last one and their sums are dropped
+  template <std::size_t Bytes, typename T>
+  [[gnu::always_inline]] static inline void
+  micro(const T *a, std::size_t lda, const T *packed, T *c, std::size_t ldc,
+        std::size_t depth, std::size_t m, std::size_t n) {
+    using V = typename Simd::Impl::Pack<T, Bytes>::type;
+    constexpr std::size_t lanes = Simd::Impl::Pack<T, Bytes>::lanes;
+    constexpr std::size_t nr = nv * lanes;
+
+    const T *rows[mr];
+    for (std::size_t r = 0; r < mr; ++r) {
+      rows[r] = a + (r < m ? r : m - 1) * lda;
+    }
+
+    // the tile loops are unrolled by hand so -O2 keeps acc in registers
+    V acc[mr][nv] = {};
+    for (std::size_t p = 0; p < depth; ++p) {
+      V b[nv];
+#pragma GCC unroll 4
+      for (std::size_t v = 0; v < nv; ++v) {
+        std::memcpy(&b[v], packed + p * nr + v * lanes, Bytes);
+      }
+#pragma GCC unroll 4
+      for (std::size_t r = 0; r < mr; ++r) {
+        const V broadcast = V{} + rows[r][p];
+#pragma GCC unroll 4
+        for (std::size_t v = 0; v < nv; ++v) {
+          acc[r][v] += broadcast * b[v];
+        }
+      }
+    }
+
+    for (std::size_t r = 0; r < m; ++r) {
+      T *out = c + r * ldc;
+      if (n == nr) {
+#pragma GCC unroll 4
+        for (std::size_t v = 0; v < nv; ++v) {
+          V sum;
+          std::memcpy(&sum, out + v * lanes, Bytes);
+          sum += acc[r][v];
+          std::memcpy(out + v * lanes, &sum, Bytes);
+        }
+      } else {
+        T sums[nr];
+        std::memcpy(sums, acc[r], sizeof(sums));
+        for (std::size_t j = 0; j < n; ++j) {
+          out[j] += sums[j];
+        }
+      }
+    }
+  }
+
+  // c (m x n) = a (m x k) * b (k x n), pack holds pack_size<T>() elements
+  template <std::size_t Bytes, typename T>
+  [[gnu::always_inline]] static inline void
+  apply(const T *a, const T *b, T *c, std::size_t m, std::size_t n,
+        std::size_t k, T *pack) {
+    constexpr std::size_t nr = nv * Simd::Impl::Pack<T, Bytes>::lanes;
+
+    for (std::size_t i = 0; i < m * n; ++i) {
+      c[i] = T();
+    }
+    for (std::size_t jc = 0; jc < n; jc += nc) {
+      const std::size_t cols = nc < n - jc ? nc : n - jc;
+      const std::size_t strips = (cols + nr - 1) / nr;
+      for (std::size_t pc = 0; pc < k; pc += kc) {
+        const std::size_t depth = kc < k - pc ? kc : k - pc;
+
+        // strip s holds columns [s * nr, s * nr + nr) of the block row by
+        // row, padded with zeros past the last column
+        for (std::size_t s = 0; s < strips; ++s) {
+          T *strip = pack + s * depth * nr;
+          for (std::size_t p = 0; p < depth; ++p) {
+            const T *src = b + (pc + p) * n + jc + s * nr;
+            for (std::size_t j = 0; j < nr; ++j) {
+              strip[p * nr + j] = s * nr + j < cols ? src[j] : T();
+            }
+          }
+        }
+
+        for (std::size_t i = 0; i < m; i += mr) {
+          const std::size_t rows = mr < m - i ? mr : m - i;
+          for (std::size_t s = 0; s < strips; ++s) {
+            const std::size_t width = nr < cols - s * nr ? nr : cols - s * nr;
+            micro<Bytes>(a + i * k + pc, k, pack + s * depth * nr,
+                         c + i * n + jc + s * nr, n, depth, rows, width);
+          }
+        }
+      }
+    }
+  }
+};
+
+struct MatVec {
+  // y (m) = a (m x n) * x (n)
+  template <std::size_t Bytes, typename T>
+  [[gnu::always_inline]] static inline void
+  apply(const T *a, const T *x, T *y, std::size_t m, std::size_t n) {
+    using V = typename Simd::Impl::Pack<T, Bytes>::type;
+    constexpr std::size_t lanes = Simd::Impl::Pack<T, Bytes>::lanes;
+    const std::size_t body = n - n % (2 * lanes);
+
+    for (std::size_t i = 0; i < m; ++i) {
+      const T *row = a + i * n;
+      V acc0 = {};
+      V acc1 = {};
+      std::size_t j = 0;
+      for (; j < body; j += 2 * lanes) {
+        V r0, r1, x0, x1;
+        std::memcpy(&r0, row + j, Bytes);
+        std::memcpy(&r1, row + j + lanes, Bytes);
+        std::memcpy(&x0, x + j, Bytes);
+        std::memcpy(&x1, x + j + lanes, Bytes);
+        acc0 += r0 * x0;
+        acc1 += r1 * x1;
+      }
+      acc0 += acc1;
+      T result = T();
+      for (std::size_t k = 0; k < lanes; ++k) {
+        result += acc0[k];
+      }
+      for (; j < n; ++j) {
+        result += row[j] * x[j];
+      }
+      y[i] = result;
+    }
+  }
+};
+
+// below this many multiply-adds packing costs more than it saves
+inline constexpr std::size_t matmul_small = 16 * 16 * 16;
+
+// c (m x n) = a (m x k) * b (k x n), c may not overlap a or b
+template <typename T>
+void matmul(const T *a, const T *b, T *c, std::size_t m, std::size_t n,
+            std::size_t k) {
+  if constexpr (Simd::Impl::vectorizable<T>) {
+    if (m * n * k >= matmul_small) {
+      Vector<T> pack(MatMul::pack_size<T>(), T());
+      Simd::Impl::dispatch<MatMul>(a, b, c, m, n, k, pack.data());
+      return;
+    }
+  }
+  // i-p-j order, the inner loop runs along rows of b and c
+  for (std::size_t i = 0; i < m; ++i) {
+    T *out = c + i * n;
+    for (std::size_t j = 0; j < n; ++j) {
+      out[j] = T();
+    }
+    for (std::size_t p = 0; p < k; ++p) {
+      const T scale = a[i * k + p];
+      const T *row = b + p * n;
+      for (std::size_t j = 0; j < n; ++j) {
+        out[j] += scale * row[j];
+      }
+    }
+  }
+}
+
+// y (m) = a (m x n) * x (n), y may not overlap a or x
+template <typename T>
+void matvec(const T *a, const T *x, T *y, std::size_t m, std::size_t n) {
+  if constexpr (Simd::Impl::vectorizable<T>) {
+    Simd::Impl::dispatch<MatVec>(a, x, y, m, n);
+  } else {
+    for (std::size_t i = 0; i < m; ++i) {
+      T result = T();
+      for (std::size_t j = 0; j < n; ++j) {
+        result += a[i * n + j] * x[j];
+      }
+      y[i] = result;
+    }
+  }
+}
+// ==== Matrix Kernels End Here ====
+} // namespace Impl
+
+// ==== Matrix Begin Here ====
+// fixed size row-major matrix, an aggregate like Array:
+//   Tiny::Matrix<float, 2, 3> m{{1, 2, 3, 4, 5, 6}};
+template <typename T, std::size_t R, std::size_t C> class Matrix {
+public:
+  // public only so that Matrix stays an aggregate, use data() instead
+  Array<T, R * C> m_data;
+
+  constexpr T &operator()(std::size_t row, std::size_t col) {
+    return m_data[row * C + col];
+  }
+  constexpr const T &operator()(std::size_t row, std::size_t col) const {
+    return m_data[row * C + col];
+  }
+
+  constexpr T &at(std::size_t row, std::size_t col) {
+    if (row >= R || col >= C) {
+      throw std::out_of_range("Index out of range");
+    }
+    return (*this)(row, col);
+  }
+  constexpr const T &at(std::size_t row, std::size_t col) const {
+    if (row >= R || col >= C) {
+      throw std::out_of_range("Index out of range");
+    }
+    return (*this)(row, col);
+  }
+
+  // start of a row, C elements long
+  constexpr T *row(std::size_t index) { return data() + index * C; }
+  constexpr const T *row(std::size_t index) const {
+    return data() + index * C;
+  }
+
+  constexpr T *data() { return m_data.data(); }
+  constexpr const T *data() const { return m_data.data(); }
+
+  static constexpr std::size_t rows() { return R; }
+  static constexpr std::size_t cols() { return C; }
+  static constexpr std::size_t size() { return R * C; }
+
+  constexpr void fill(const T &value) { m_data.fill(value); }
+
+  static constexpr Matrix identity()
+    requires(R == C)
+  {
+    Matrix result{};
+    for (std::size_t i = 0; i < R; ++i) {
+      result(i, i) = T(1);
+    }
+    return result;
+  }
+
+  friend constexpr bool operator==(const Matrix &lhs, const Matrix &rhs) {
+    return lhs.m_data == rhs.m_data;
+  }
+};
+
+template <typename T, std::size_t R, std::size_t C>
+Matrix<T, C, R> transpose(const Matrix<T, R, C> &m) {
+  Matrix<T, C, R> result;
+  Impl::transpose(m.data(), result.data(), R, C);
+  return result;
+}
+
+template <typename T, std::size_t R, std::size_t K, std::size_t C>
+Matrix<T, R, C> matmul(const Matrix<T, R, K> &a, const Matrix<T, K, C> &b) {
+  Matrix<T, R, C> result;
+  Impl::matmul(a.data(), b.data(), result.data(), R, C, K);
+  return result;
+}
+
+template <typename T, std::size_t R, std::size_t C>
+Array<T, R> matvec(const Matrix<T, R, C> &a, const Array<T, C> &x) {
+  Array<T, R> result;
+  Impl::matvec(a.data(), x.data(), result.data(), R, C);
+  return result;
+}
+// ==== Matrix End Here ====
+
+// ==== DynMatrix Begin Here ====
+// row-major matrix sized at runtime
+template <typename T, typename Alloc = Allocator<T>> class DynMatrix {
+public:
+  DynMatrix() : rows_(0), cols_(0) {}
+
+  DynMatrix(std::size_t rows, std::size_t cols, const T &value = T())
+      : data_(rows * cols, value), rows_(rows), cols_(cols) {}
+
+  T &operator()(std::size_t row, std::size_t col) {
+    return data_[row * cols_ + col];
+  }
+  const T &operator()(std::size_t row, std::size_t col) const {
+    return data_[row * cols_ + col];
+  }
+
+  T &at(std::size_t row, std::size_t col) {
+    if (row >= rows_ || col >= cols_) {
+      throw std::out_of_range("Index out of range");
+    }
+    return (*this)(row, col);
+  }
+  const T &at(std::size_t row, std::size_t col) const {
+    if (row >= rows_ || col >= cols_) {
+      throw std::out_of_range("Index out of range");
+    }
+    return (*this)(row, col);
+  }
+
+  // start of a row, cols() elements long
+  T *row(std::size_t index) { return data() + index * cols_; }
+  const T *row(std::size_t index) const { return data() + index * cols_; }
+
+  T *data() { return data_.data(); }
+  const T *data() const { return data_.data(); }
+
+  std::size_t rows() const { return rows_; }
+  std::size_t cols() const { return cols_; }
+  std::size_t size() const { return data_.size(); }
+  bool empty() const { return data_.empty(); }
+
+  void fill(const T &value) {
+    for (T &element : data_) {
+      element = value;
+    }
+  }
+
+  static DynMatrix identity(std::size_t size) {
+    DynMatrix result(size, size);
+    for (std::size_t i = 0; i < size; ++i) {
+      result(i, i) = T(1);
+    }
+    return result;
+  }
+
+  friend bool operator==(const DynMatrix &lhs, const DynMatrix &rhs) {
+    if (lhs.rows_ != rhs.rows_ || lhs.cols_ != rhs.cols_) {
+      return false;
+    }
+    for (std::size_t i = 0; i < lhs.size(); ++i) {
+      if (!(lhs.data_[i] == rhs.data_[i])) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+private:
+  Vector<T, Alloc> data_;
+  std::size_t rows_;
+  std::size_t cols_;
+};
+
+template <typename T, typename Alloc>
+DynMatrix<T, Alloc> transpose(const DynMatrix<T, Alloc> &m) {
+  DynMatrix<T, Alloc> result(m.cols(), m.rows());
+  Impl::transpose(m.data(), result.data(), m.rows(), m.cols());
+  return result;
+}
+
+// throws std::invalid_argument when a.cols() != b.rows()
+template <typename T, typename Alloc>
+DynMatrix<T, Alloc> matmul(const DynMatrix<T, Alloc> &a,
+                           const DynMatrix<T, Alloc> &b) {
+  if (a.cols() != b.rows()) {
+    throw std::invalid_argument("Matrix sizes differ");
+  }
+  DynMatrix<T, Alloc> result(a.rows(), b.cols());
+  Impl::matmul(a.data(), b.data(), result.data(), a.rows(), b.cols(),
+               a.cols());
+  return result;
+}
+
+// throws std::invalid_argument when a.cols() != x.size()
+template <typename T, typename Alloc, typename Grow>
+Vector<T> matvec(const DynMatrix<T, Alloc> &a,
+                 const Vector<T, Alloc, Grow> &x) {
+  if (a.cols() != x.size()) {
+    throw std::invalid_argument("Matrix sizes differ");
+  }
+  Vector<T> result(a.rows(), T());
+  Impl::matvec(a.data(), x.data(), result.data(), a.rows(), a.cols());
+  return result;
+}
+// ==== DynMatrix End Here ====
+} // namespace Tiny
+
+#endif // TINY_MATRIX_HPP
@@ -0,0 +1,131 @@
+#ifndef TINY_MMAP_ALLOCATOR_HPP
+#define TINY_MMAP_ALLOCATOR_HPP
+
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <sys/mman.h>
+#include <type_traits>
+#include <unistd.h>
+
+namespace Tiny {
+// allocator for very large buffers of trivially copyable elements
+// blocks of at least Threshold bytes come straight from anonymous mmap and
+// are grown with mremap, so the kernel moves page table entries instead of
+// the data being copied; smaller blocks use operator new
+// with HugePages the mapping is advised MADV_HUGEPAGE
+template <typename T, std::size_t Threshold = std::size_t(1) << 20,
+          bool HugePages = false>
+class MmapAllocator {
+  static_assert(std::is_trivially_copyable_v<T>,
+                "MmapAllocator only holds trivially copyable types.");
+
+public:
+  using value_type = T;
+
+  template <typename U> struct rebind {
+    using other = MmapAllocator<U, Threshold, HugePages>;
+  };
+
+  MmapAllocator() noexcept = default;
+  template <typename U>
+  MmapAllocator(const MmapAllocator<U, Threshold, HugePages> &) noexcept {}
+
+  T *allocate(std::size_t n);
+  void deallocate(T *ptr, std::size_t n) noexcept;
+  // resize a block from old_n to new_n elements, keeping the first
+  // min(old_n, new_n) elements
+  T *reallocate(T *ptr, std::size_t old_n, std::size_t new_n);
+
+  template <typename U>
+  friend bool
+  operator==(const MmapAllocator &,
+             const MmapAllocator<U, Threshold, HugePages> &) noexcept {
+    return true;
+  }
+
+private:
+  static bool _mapped(std::size_t n) { return n * sizeof(T) >= Threshold; }
+  static std::size_t _map_size(std::size_t n);
+  static void _advise(void *ptr, std::size_t bytes);
+};
+} // namespace Tiny
+
+// mappings are whole pages
+template <typename T, std::size_t Threshold, bool HugePages>
+std::size_t
+Tiny::MmapAllocator<T, Threshold, HugePages>::_map_size(std::size_t n) {
+  static const std::size_t page =
+      static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+  return (n * sizeof(T) + page - 1) / page * page;
+}
+
+template <typename T, std::size_t Threshold, bool HugePages>
+void Tiny::MmapAllocator<T, Threshold, HugePages>::_advise(void *ptr,
+                                                          std::size_t bytes) {
+#ifdef MADV_HUGEPAGE
+  if constexpr (HugePages) {
+    // only a hint, the kernel may not have transparent huge pages enabled
+    madvise(ptr, bytes, MADV_HUGEPAGE);
+  }
+#endif
+}
+
+template <typename T, std::size_t Threshold, bool HugePages>
+T *Tiny::MmapAllocator<T, Threshold, HugePages>::allocate(std::size_t n) {
+  if (n > static_cast<std::size_t>(-1) / sizeof(T)) {
+    throw std::bad_array_new_length();
+  }
+  if (!_mapped(n)) {
+    return static_cast<T *>(::operator new(n * sizeof(T)));
+  }
+
+  const std::size_t bytes = _map_size(n);
+  void *ptr = mmap(nullptr, bytes, PROT_READ | PROT_WRITE,
+                   MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (ptr == MAP_FAILED) {
+    throw std::bad_alloc();
+  }
+  _advise(ptr, bytes);
+  return static_cast<T *>(ptr);
+}
+
+template <typename T, std::size_t Threshold, bool HugePages>
+void Tiny::MmapAllocator<T, Threshold, HugePages>::deallocate(
+    T *ptr, std::size_t n) noexcept {
+  if (!_mapped(n)) {
+    ::operator delete(ptr);
+    return;
+  }
+  munmap(ptr, _map_size(n));
+}
+
+// mapped to mapped is a single mremap, shrinking it in place hands the
+// tail pages back to the kernel; crossing the threshold copies once
+template <typename T, std::size_t Threshold, bool HugePages>
+T *Tiny::MmapAllocator<T, Threshold, HugePages>::reallocate(
+    T *ptr, std::size_t old_n, std::size_t new_n) {
+  if (_mapped(old_n) && _mapped(new_n)) {
+    const std::size_t old_bytes = _map_size(old_n);
+    const std::size_t new_bytes = _map_size(new_n);
+    if (old_bytes == new_bytes) {
+      return ptr;
+    }
+    void *new_ptr = mremap(ptr, old_bytes, new_bytes, MREMAP_MAYMOVE);
+    if (new_ptr == MAP_FAILED) {
+      throw std::bad_alloc();
+    }
+    if (new_bytes > old_bytes) {
+      _advise(new_ptr, new_bytes);
+    }
+    return static_cast<T *>(new_ptr);
+  }
+
+  T *new_ptr = allocate(new_n);
+  std::memcpy(static_cast<void *>(new_ptr), static_cast<const void *>(ptr),
+              (old_n < new_n ? old_n : new_n) * sizeof(T));
+  deallocate(ptr, old_n);
+  return new_ptr;
+}
+
+#endif // TINY_MMAP_ALLOCATOR_HPP
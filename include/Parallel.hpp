@@ -0,0 +1,344 @@
+#ifndef TINY_PARALLEL_HPP
+#define TINY_PARALLEL_HPP
+
+#include "Thread.hpp"
+#include "Vector.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <unistd.h>
+#include <utility>
+
+namespace Tiny {
+namespace Parallel {
+// number of online cores, at least 1
+inline std::size_t hardware_threads() {
+  long cores = sysconf(_SC_NPROCESSORS_ONLN);
+  return cores > 0 ? static_cast<std::size_t>(cores) : 1;
+}
+
+struct Policy {
+  // workers to split a call across, the calling thread counts as one
+  std::size_t threads = hardware_threads();
+  // ranges shorter than this run serially on the calling thread
+  std::size_t cutoff = std::size_t(1) << 15;
+};
+
+namespace Impl {
+// a single element is never worth a thread, whatever the cutoff says
+inline bool serial(std::size_t size, const Policy &policy) {
+  return policy.threads <= 1 || size <= 1 || size < policy.cutoff;
+}
+
+// chunks to cut size elements into, never more than there are elements so
+// every chunk holds at least one
+inline std::size_t chunk_count(std::size_t size, const Policy &policy) {
+  return std::min(policy.threads, size);
+}
+
+// first index of chunk c when size elements are cut into chunks pieces
+inline std::size_t chunk_begin(std::size_t size, std::size_t chunks,
+                               std::size_t c) {
+  return static_cast<std::size_t>(
+      static_cast<unsigned __int128>(size) * c / chunks);
+}
+
+// run body(task) for every task in [0, tasks) on up to threads workers
+// the calling thread works too; the first exception is rethrown after all
+// workers have been joined
+template <typename Body>
+void run_tasks(std::size_t tasks, std::size_t threads, Body &&body) {
+  threads = std::min(threads, tasks);
+  if (threads <= 1) {
+    for (std::size_t t = 0; t < tasks; ++t) {
+      body(t);
+    }
+    return;
+  }
+
+  Vector<std::exception_ptr> errors(threads);
+  auto worker = [&](std::size_t w) {
+    try {
+      for (std::size_t t = w; t < tasks; t += threads) {
+        body(t);
+      }
+    } catch (...) {
+      errors[w] = std::current_exception();
+    }
+  };
+
+  Vector<Thread> pool;
+  pool.reserve(threads - 1);
+  try {
+    for (std::size_t w = 1; w < threads; ++w) {
+      pool.emplace_back(worker, w);
+    }
+  } catch (...) {
+    for (Thread &thread : pool) {
+      thread.join();
+    }
+    throw;
+  }
+  worker(0);
+  for (Thread &thread : pool) {
+    thread.join();
+  }
+
+  for (std::exception_ptr &error : errors) {
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+}
+
+// how many of the first k outputs of a stable merge of a and b come from a
+// this is the merge path split, so pieces of one merge can run in parallel
+template <typename T, typename Compare>
+std::size_t co_rank(std::size_t k, const T *a, std::size_t na, const T *b,
+                    std::size_t nb, Compare &comp) {
+  std::size_t lo = k > nb ? k - nb : 0;
+  std::size_t hi = std::min(k, na);
+  while (lo < hi) {
+    std::size_t i = lo + (hi - lo) / 2;
+    std::size_t j = k - i;
+    // a[i] would still come before b[j - 1], so take more from a
+    if (j > 0 && !comp(b[j - 1], a[i])) {
+      lo = i + 1;
+    } else {
+      hi = i;
+    }
+  }
+  return lo;
+}
+} // namespace Impl
+
+// ==== Algorithms Begin Here ====
+// call f on every element
+template <typename T, typename Alloc, typename Grow, typename F>
+void for_each(Vector<T, Alloc, Grow> &vec, F f,
+              const Policy &policy = Policy()) {
+  const std::size_t size = vec.size();
+  if (Impl::serial(size, policy)) {
+    for (T &value : vec) {
+      f(value);
+    }
+    return;
+  }
+
+  T *data = vec.data();
+  const std::size_t chunks = Impl::chunk_count(size, policy);
+  Impl::run_tasks(chunks, policy.threads, [&](std::size_t c) {
+    const std::size_t end = Impl::chunk_begin(size, chunks, c + 1);
+    for (std::size_t i = Impl::chunk_begin(size, chunks, c); i < end; ++i) {
+      f(data[i]);
+    }
+  });
+}
+
+// out[i] = f(in[i]), out is resized to in.size()
+template <typename T, typename AllocIn, typename GrowIn, typename U,
+          typename AllocOut, typename GrowOut, typename F>
+void transform(const Vector<T, AllocIn, GrowIn> &in,
+               Vector<U, AllocOut, GrowOut> &out, F f,
+               const Policy &policy = Policy()) {
+  const std::size_t size = in.size();
+  out.resize(size);
+  const T *src = in.data();
+  U *dst = out.data();
+
+  if (Impl::serial(size, policy)) {
+    for (std::size_t i = 0; i < size; ++i) {
+      dst[i] = f(src[i]);
+    }
+    return;
+  }
+
+  const std::size_t chunks = Impl::chunk_count(size, policy);
+  Impl::run_tasks(chunks, policy.threads, [&](std::size_t c) {
+    const std::size_t end = Impl::chunk_begin(size, chunks, c + 1);
+    for (std::size_t i = Impl::chunk_begin(size, chunks, c); i < end; ++i) {
+      dst[i] = f(src[i]);
+    }
+  });
+}
+
+// fold all elements into init with op
+// op must be associative, chunks are combined left to right
+template <typename T, typename Alloc, typename Grow, typename Op = std::plus<>>
+T reduce(const Vector<T, Alloc, Grow> &vec, T init, Op op = Op(),
+         const Policy &policy = Policy()) {
+  const std::size_t size = vec.size();
+  const T *data = vec.data();
+
+  if (Impl::serial(size, policy)) {
+    for (std::size_t i = 0; i < size; ++i) {
+      init = op(std::move(init), data[i]);
+    }
+    return init;
+  }
+
+  const std::size_t chunks = Impl::chunk_count(size, policy);
+  Vector<T> partial(chunks, init);
+  Impl::run_tasks(chunks, policy.threads, [&](std::size_t c) {
+    const std::size_t begin = Impl::chunk_begin(size, chunks, c);
+    const std::size_t end = Impl::chunk_begin(size, chunks, c + 1);
+    T acc = data[begin];
+    for (std::size_t i = begin + 1; i < end; ++i) {
+      acc = op(std::move(acc), data[i]);
+    }
+    partial[c] = std::move(acc);
+  });
+
+  for (std::size_t c = 0; c < chunks; ++c) {
+    init = op(std::move(init), partial[c]);
+  }
+  return init;
+}
+
+// out[i] = in[0] op in[1] op ... op in[i], out may be the same Vector as in
+// op must be associative; each chunk is scanned twice, once for its total
+// and once more with the prefix of all chunks before it
+template <typename T, typename AllocIn, typename GrowIn, typename AllocOut,
+          typename GrowOut, typename Op = std::plus<>>
+void inclusive_scan(const Vector<T, AllocIn, GrowIn> &in,
+                    Vector<T, AllocOut, GrowOut> &out, Op op = Op(),
+                    const Policy &policy = Policy()) {
+  const std::size_t size = in.size();
+  if (static_cast<const void *>(&in) != static_cast<const void *>(&out)) {
+    out.resize(size);
+  }
+  if (size == 0) {
+    return;
+  }
+  const T *src = in.data();
+  T *dst = out.data();
+
+  if (Impl::serial(size, policy)) {
+    T acc = src[0];
+    dst[0] = acc;
+    for (std::size_t i = 1; i < size; ++i) {
+      acc = op(std::move(acc), src[i]);
+      dst[i] = acc;
+    }
+    return;
+  }
+
+  const std::size_t chunks = Impl::chunk_count(size, policy);
+  Vector<T> totals(chunks, src[0]);
+  Impl::run_tasks(chunks - 1, policy.threads, [&](std::size_t c) {
+    const std::size_t begin = Impl::chunk_begin(size, chunks, c);
+    const std::size_t end = Impl::chunk_begin(size, chunks, c + 1);
+    T acc = src[begin];
+    for (std::size_t i = begin + 1; i < end; ++i) {
+      acc = op(std::move(acc), src[i]);
+    }
+    totals[c] = std::move(acc);
+  });
+
+  // totals[c] becomes the scan of everything up to the end of chunk c
+  for (std::size_t c = 1; c + 1 < chunks; ++c) {
+    totals[c] = op(totals[c - 1], totals[c]);
+  }
+
+  Impl::run_tasks(chunks, policy.threads, [&](std::size_t c) {
+    const std::size_t begin = Impl::chunk_begin(size, chunks, c);
+    const std::size_t end = Impl::chunk_begin(size, chunks, c + 1);
+    T acc = c == 0 ? src[begin] : op(totals[c - 1], src[begin]);
+    dst[begin] = acc;
+    for (std::size_t i = begin + 1; i < end; ++i) {
+      acc = op(std::move(acc), src[i]);
+      dst[i] = acc;
+    }
+  });
+}
+
+// merge sort: every worker sorts one chunk, then the sorted runs are merged
+// pairwise until one is left; every merge is cut into merge path pieces so
+// all workers stay busy down to the final merge
+// T must be default constructible for the merge buffer; stable runs are not
+// guaranteed because the chunks themselves use std::sort
+template <typename T, typename Alloc, typename Grow,
+          typename Compare = std::less<>>
+void sort(Vector<T, Alloc, Grow> &vec, Compare comp = Compare(),
+          const Policy &policy = Policy()) {
+  const std::size_t size = vec.size();
+  if (Impl::serial(size, policy)) {
+    std::sort(vec.begin(), vec.end(), comp);
+    return;
+  }
+
+  const std::size_t threads = Impl::chunk_count(size, policy);
+  Vector<std::size_t> runs;
+  for (std::size_t c = 0; c <= threads; ++c) {
+    runs.push_back(Impl::chunk_begin(size, threads, c));
+  }
+
+  T *src = vec.data();
+  Impl::run_tasks(threads, threads, [&](std::size_t c) {
+    std::sort(src + runs[c], src + runs[c + 1], comp);
+  });
+
+  struct Piece {
+    std::size_t a_begin, a_end, b_begin, b_end, out;
+  };
+
+  Vector<T, Alloc> buffer(size, vec.get_allocator());
+  T *dst = buffer.data();
+  while (runs.size() > 2) {
+    Vector<Piece> pieces;
+    Vector<std::size_t> merged;
+    merged.push_back(0);
+
+    const std::size_t count = runs.size() - 1;
+    for (std::size_t r = 0; r < count; r += 2) {
+      const std::size_t lo = runs[r];
+      const std::size_t mid = runs[r + 1];
+      const std::size_t hi = r + 1 < count ? runs[r + 2] : mid;
+      const std::size_t total = hi - lo;
+
+      // give each pair a share of the workers matching its share of data
+      std::size_t parts = threads * total / size;
+      parts = parts == 0 ? 1 : parts;
+      std::size_t prev_k = 0, prev_i = 0;
+      for (std::size_t p = 1; p <= parts; ++p) {
+        const std::size_t k = Impl::chunk_begin(total, parts, p);
+        const std::size_t i = Impl::co_rank(k, src + lo, mid - lo, src + mid,
+                                            hi - mid, comp);
+        pieces.push_back(Piece{lo + prev_i, lo + i, mid + (prev_k - prev_i),
+                               mid + (k - i), lo + prev_k});
+        prev_k = k;
+        prev_i = i;
+      }
+      merged.push_back(hi);
+    }
+
+    Impl::run_tasks(pieces.size(), threads, [&](std::size_t t) {
+      const Piece &piece = pieces[t];
+      std::merge(std::make_move_iterator(src + piece.a_begin),
+                 std::make_move_iterator(src + piece.a_end),
+                 std::make_move_iterator(src + piece.b_begin),
+                 std::make_move_iterator(src + piece.b_end), dst + piece.out,
+                 comp);
+    });
+
+    std::swap(src, dst);
+    runs = std::move(merged);
+  }
+
+  // the last merge may have landed in the buffer
+  if (src != vec.data()) {
+    T *out = vec.data();
+    Impl::run_tasks(threads, threads, [&](std::size_t c) {
+      std::move(src + Impl::chunk_begin(size, threads, c),
+                src + Impl::chunk_begin(size, threads, c + 1),
+                out + Impl::chunk_begin(size, threads, c));
+    });
+  }
+}
+// ==== Algorithms End Here ====
+} // namespace Parallel
+} // namespace Tiny
+
+#endif // TINY_PARALLEL_HPP
@@ -1,47 +1,422 @@
 #ifndef TINY_QUEUE_HPP
 #define TINY_QUEUE_HPP
 
+#include "Allocator.hpp"
 #include "List.hpp"
+#include "RingBuffer.hpp"
 #include "Vector.hpp"
+#include <algorithm>
+#include <bit>
+#include <compare>
+#include <functional>
 #include <cstddef>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
 #include <utility>
 
 namespace Tiny {
-template <typename T> class Deque {
+// double-ended queue made of fixed-size blocks held in a map of block
+// pointers, element i sits at position m_start + i counted across the
+// blocks; pushing at either end only allocates when it enters a block that
+// was never used
+// blocks emptied by popping stay in the map and are reused once the map is
+// recentred, so a deque that is pushed at one end and popped at the other
+// stops allocating; shrink_to_fit gives them back
+// as with std::deque, pushing or popping at either end keeps references to
+// the other elements valid: a recentre only moves block pointers, never the
+// elements; iterators hold a position, so push_front shifts them by one
+template <typename T, typename Alloc = Allocator<T>> class Deque {
+private:
+  using alloc_traits = std::allocator_traits<Alloc>;
+  // the block map comes from the same allocator as the blocks
+  using map_alloc = typename alloc_traits::template rebind_alloc<T *>;
+
+  // elements per block, a power of two so indexing is a shift and a mask
+  static constexpr std::size_t block_size_ =
+      std::bit_floor(std::max<std::size_t>(512 / sizeof(T), 16));
+  static constexpr std::size_t block_shift_ = std::bit_width(block_size_) - 1;
+  static constexpr std::size_t block_mask_ = block_size_ - 1;
+
+  template <bool Const> class Iterator {
+    using owner_pointer = std::conditional_t<Const, const Deque *, Deque *>;
+
+  public:
+    using iterator_category = std::random_access_iterator_tag;
+    using iterator_concept = std::random_access_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using pointer = std::conditional_t<Const, const T *, T *>;
+    using reference = std::conditional_t<Const, const T &, T &>;
+
+    Iterator() = default;
+    Iterator(owner_pointer owner, std::size_t index)
+        : owner_(owner), index_(index) {}
+    // iterator converts to const_iterator
+    template <bool C>
+    Iterator(const Iterator<C> &other)
+      requires(Const && !C)
+        : owner_(other.owner_), index_(other.index_) {}
+
+    reference operator*() const { return (*owner_)[index_]; }
+    pointer operator->() const { return &(*owner_)[index_]; }
+    reference operator[](difference_type n) const {
+      return (*owner_)[index_ + n];
+    }
+
+    Iterator &operator++() {
+      ++index_;
+      return *this;
+    }
+    Iterator operator++(int) {
+      Iterator tmp = *this;
+      ++index_;
+      return tmp;
+    }
+    Iterator &operator--() {
+      --index_;
+      return *this;
+    }
+    Iterator operator--(int) {
+      Iterator tmp = *this;
+      --index_;
+      return tmp;
+    }
+    Iterator &operator+=(difference_type n) {
+      index_ += n;
+      return *this;
+    }
+    Iterator &operator-=(difference_type n) {
+      index_ -= n;
+      return *this;
+    }
+
+    friend Iterator operator+(Iterator it, difference_type n) {
+      return it += n;
+    }
+    friend Iterator operator+(difference_type n, Iterator it) {
+      return it += n;
+    }
+    friend Iterator operator-(Iterator it, difference_type n) {
+      return it -= n;
+    }
+    friend difference_type operator-(const Iterator &lhs,
+                                     const Iterator &rhs) {
+      return static_cast<difference_type>(lhs.index_ - rhs.index_);
+    }
+    friend bool operator==(const Iterator &lhs, const Iterator &rhs) {
+      return lhs.index_ == rhs.index_;
+    }
+    friend auto operator<=>(const Iterator &lhs, const Iterator &rhs) {
+      return lhs.index_ <=> rhs.index_;
+    }
+
+  private:
+    owner_pointer owner_ = nullptr;
+    std::size_t index_ = 0;
+
+    friend class Iterator<true>;
+  };
+
 public:
-  Deque() = default;
-  Deque(const Deque &other) = default;
-  Deque(Deque &&other) = default;
-  Deque &operator=(const Deque &other) = default;
-  Deque &operator=(Deque &&other) = default;
-  ~Deque() = default;
+  using iterator = Iterator<false>;
+  using const_iterator = Iterator<true>;
 
-  void push_front(const T &value) { m_list.push_front(value); }
-  void push_front(T &&value) { m_list.push_front(std::move(value)); }
+  Deque() noexcept(noexcept(Alloc())) : Deque(Alloc()) {}
 
-  void push_back(const T &value) { m_list.push_back(value); }
-  void push_back(T &&value) { m_list.push_back(std::move(value)); }
+  explicit Deque(const Alloc &alloc) noexcept
+      : m_map(map_alloc(alloc)), m_start(0), m_size(0), m_alloc(alloc) {}
 
-  void pop_front() { m_list.pop_front(); }
-  void pop_back() { m_list.pop_back(); }
+  Deque(const Deque &other)
+      : Deque(alloc_traits::select_on_container_copy_construction(
+            other.m_alloc)) {
+    for (const T &value : other) {
+      push_back(value);
+    }
+  }
 
-  T &front() { return m_list.front(); }
-  const T &front() const { return m_list.front(); }
+  // the map and its blocks are handed over, no element moves
+  Deque(Deque &&other) noexcept
+      : m_map(std::move(other.m_map)),
+        m_start(std::exchange(other.m_start, 0)),
+        m_size(std::exchange(other.m_size, 0)),
+        m_alloc(std::move(other.m_alloc)) {}
 
-  T &back() { return m_list.back(); }
-  const T &back() const { return m_list.back(); }
+  ~Deque() {
+    clear();
+    _release_blocks(0, m_map.size());
+  }
 
-  std::size_t size() const { return m_list.size(); }
+  Deque &operator=(const Deque &other) {
+    if (this != &other) {
+      clear();
+      for (const T &value : other) {
+        push_back(value);
+      }
+    }
+    return *this;
+  }
 
-  bool empty() const { return m_list.empty(); }
+  // the map and blocks are taken when the allocator propagates or compares
+  // equal, otherwise elements are moved one by one into our own blocks
+  Deque &operator=(Deque &&other) noexcept(
+      alloc_traits::propagate_on_container_move_assignment::value ||
+      alloc_traits::is_always_equal::value) {
+    if (this == &other) {
+      return *this;
+    }
 
-  void clear() { m_list.clear(); }
+    clear();
+    constexpr bool propagate =
+        alloc_traits::propagate_on_container_move_assignment::value;
+    if (propagate || m_alloc == other.m_alloc) {
+      _release_blocks(0, m_map.size());
+      if constexpr (propagate) {
+        m_alloc = std::move(other.m_alloc);
+      }
+      m_map = std::move(other.m_map);
+      m_start = std::exchange(other.m_start, 0);
+      m_size = std::exchange(other.m_size, 0);
+      return *this;
+    }
+
+    for (T &value : other) {
+      emplace_back(std::move(value));
+    }
+    other.clear();
+    return *this;
+  }
+
+  // Element access
+  T &operator[](std::size_t index) {
+    const std::size_t pos = m_start + index;
+    return m_map[pos >> block_shift_][pos & block_mask_];
+  }
+
+  const T &operator[](std::size_t index) const {
+    const std::size_t pos = m_start + index;
+    return m_map[pos >> block_shift_][pos & block_mask_];
+  }
+
+  T &at(std::size_t index) {
+    if (index >= m_size) {
+      throw std::out_of_range("Index out of range");
+    }
+    return (*this)[index];
+  }
+
+  const T &at(std::size_t index) const {
+    if (index >= m_size) {
+      throw std::out_of_range("Index out of range");
+    }
+    return (*this)[index];
+  }
+
+  T &front() { return (*this)[0]; }
+  const T &front() const { return (*this)[0]; }
+
+  T &back() { return (*this)[m_size - 1]; }
+  const T &back() const { return (*this)[m_size - 1]; }
+
+  // Capacity
+  std::size_t size() const { return m_size; }
+  bool empty() const { return m_size == 0; }
+
+  // free the blocks that hold no element
+  void shrink_to_fit() {
+    if (m_size == 0) {
+      _release_blocks(0, m_map.size());
+      return;
+    }
+    _release_blocks(0, m_start >> block_shift_);
+    _release_blocks(((m_start + m_size - 1) >> block_shift_) + 1,
+                    m_map.size());
+  }
+
+  // Modifiers
+  template <typename... Args> T &emplace_back(Args &&...args) {
+    if (m_start + m_size == m_map.size() << block_shift_) {
+      _recentre(true);
+    }
+    T *slot = _slot(m_start + m_size);
+    alloc_traits::construct(m_alloc, slot, std::forward<Args>(args)...);
+    ++m_size;
+    return *slot;
+  }
+
+  template <typename... Args> T &emplace_front(Args &&...args) {
+    if (m_start == 0) {
+      _recentre(false);
+    }
+    T *slot = _slot(m_start - 1);
+    alloc_traits::construct(m_alloc, slot, std::forward<Args>(args)...);
+    --m_start;
+    ++m_size;
+    return *slot;
+  }
+
+  void push_front(const T &value) { emplace_front(value); }
+  void push_front(T &&value) { emplace_front(std::move(value)); }
+
+  void push_back(const T &value) { emplace_back(value); }
+  void push_back(T &&value) { emplace_back(std::move(value)); }
+
+  void pop_front() {
+    alloc_traits::destroy(m_alloc, &front());
+    ++m_start;
+    --m_size;
+    _reset_if_empty();
+  }
+
+  void pop_back() {
+    alloc_traits::destroy(m_alloc, &back());
+    --m_size;
+    _reset_if_empty();
+  }
+
+  // destroy all elements, blocks are kept for reuse
+  void clear() {
+    if constexpr (!std::is_trivially_destructible_v<T>) {
+      for (std::size_t i = 0; i < m_size; ++i) {
+        alloc_traits::destroy(m_alloc, &(*this)[i]);
+      }
+    }
+    m_size = 0;
+    _reset_if_empty();
+  }
+
+  // allocators are only exchanged with propagate_on_container_swap
+  void swap(Deque &other) noexcept {
+    if constexpr (alloc_traits::propagate_on_container_swap::value) {
+      using std::swap;
+      swap(m_alloc, other.m_alloc);
+    }
+    m_map.swap(other.m_map);
+    std::swap(m_start, other.m_start);
+    std::swap(m_size, other.m_size);
+  }
+
+  // Iterators
+  iterator begin() { return iterator(this, 0); }
+  const_iterator begin() const { return const_iterator(this, 0); }
+  const_iterator cbegin() const { return const_iterator(this, 0); }
+  iterator end() { return iterator(this, m_size); }
+  const_iterator end() const { return const_iterator(this, m_size); }
+  const_iterator cend() const { return const_iterator(this, m_size); }
+
+  Alloc get_allocator() const { return m_alloc; }
 
 private:
-  List<T> m_list;
+  // the element at position pos, allocating its block if it has none
+  T *_slot(std::size_t pos) {
+    T *&block = m_map[pos >> block_shift_];
+    if (block == nullptr) {
+      block = alloc_traits::allocate(m_alloc, block_size_);
+    }
+    return block + (pos & block_mask_);
+  }
+
+  // an empty deque starts over in the middle of its map, so either end
+  // has room
+  void _reset_if_empty() {
+    if (m_size == 0) {
+      m_start = (m_map.size() / 2) << block_shift_;
+    }
+  }
+
+  // move the used blocks to the middle of the map, first doubling the map
+  // if they take up more than half of it
+  // a recentre leaves a quarter of the map free on each side, so it happens
+  // once per many blocks; back says which end ran out of room
+  void _recentre(bool back) {
+    const std::size_t first = m_start >> block_shift_;
+    const std::size_t used =
+        m_size == 0 ? 0 : ((m_start + m_size - 1) >> block_shift_) - first + 1;
+    const std::size_t map_size = m_map.size();
+    std::size_t target;
+
+    if (2 * (used + 1) > map_size) {
+      const std::size_t new_size =
+          std::max({std::size_t(8), 2 * map_size, 2 * (used + 1)});
+      Vector<T *, map_alloc> map(new_size, nullptr, m_map.get_allocator());
+      target = (new_size - used) / 2;
+      for (std::size_t b = 0; b < map_size; ++b) {
+        map[(target + new_size + b - first) % new_size] = m_map[b];
+      }
+      m_map = std::move(map);
+    } else {
+      target = (map_size - used) / 2;
+      T **data = m_map.data();
+      if (first > target) {
+        std::rotate(data, data + (first - target), data + map_size);
+      } else if (first < target) {
+        std::rotate(data, data + map_size - (target - first),
+                    data + map_size);
+      }
+    }
+
+    // spare blocks go next to the used ones, on the side that is about to
+    // grow first, so it reuses them before allocating
+    T **data = m_map.data();
+    const std::size_t size = m_map.size();
+    std::partition(data, data + target,
+                   [](T *block) { return block == nullptr; });
+    std::partition(data + target + used, data + size,
+                   [](T *block) { return block != nullptr; });
+    if (back) {
+      std::size_t from = 0;
+      for (std::size_t to = target + used; to < size && from < target; ++to) {
+        if (data[to] == nullptr) {
+          while (from < target && data[from] == nullptr) {
+            ++from;
+          }
+          if (from < target) {
+            std::swap(data[to], data[from++]);
+          }
+        }
+      }
+    } else {
+      std::size_t from = size;
+      for (std::size_t to = target; to > 0 && from > target + used; --to) {
+        if (data[to - 1] == nullptr) {
+          while (from > target + used && data[from - 1] == nullptr) {
+            --from;
+          }
+          if (from > target + used) {
+            std::swap(data[to - 1], data[--from]);
+          }
+        }
+      }
+    }
+    m_start = (target << block_shift_) + (m_start & block_mask_);
+  }
+
+  // free the blocks in map slots [first, last), they must be empty
+  void _release_blocks(std::size_t first, std::size_t last) {
+    for (std::size_t b = first; b < last; ++b) {
+      if (m_map[b] != nullptr) {
+        alloc_traits::deallocate(m_alloc, m_map[b], block_size_);
+        m_map[b] = nullptr;
+      }
+    }
+  }
+
+  Vector<T *, map_alloc> m_map;
+  std::size_t m_start;
+  std::size_t m_size;
+  [[no_unique_address]] Alloc m_alloc;
 };
 
-template <typename T> class Queue {
+// Container needs empty, size, front, back, push_back, pop_front and
+// clear, e.g. forwardList<T>, Deque<T> or RingBuffer<T>:
+//   Queue<T, RingBuffer<T, 0, RingPolicy::Grow>>  unbounded, no per-push
+//                                                 allocation, O(1) back()
+//   Queue<T, RingBuffer<T, 1024>>                 bounded, push returns
+//                                                 false when full
+// push returns whatever the container's push_back returns, front and back
+// return what the container's do, references for RingBuffer and Deque
+template <typename T, typename Container = forwardList<T>> class Queue {
 public:
   Queue() = default;
   Queue(const Queue &other) = default;
@@ -50,13 +425,23 @@ public:
   Queue &operator=(Queue &&other) = default;
   ~Queue() = default;
 
-  void push(const T &value) { m_list.push_back(value); }
-  void push(T &&value) { m_list.push_back(std::move(value)); }
+  // forwardList only takes rvalues, lvalues are pushed as a copy there
+  decltype(auto) push(const T &value) {
+    if constexpr (requires { m_list.push_back(value); }) {
+      return m_list.push_back(value);
+    } else {
+      return m_list.push_back(T(value));
+    }
+  }
+  decltype(auto) push(T &&value) { return m_list.push_back(std::move(value)); }
 
   void pop() { m_list.pop_front(); }
 
-  T front() const { return m_list.front(); }
-  T back() const { return m_list.back(); }
+  decltype(auto) front() { return m_list.front(); }
+  decltype(auto) front() const { return m_list.front(); }
+
+  decltype(auto) back() { return m_list.back(); }
+  decltype(auto) back() const { return m_list.back(); }
 
   std::size_t size() const { return m_list.size(); }
 
@@ -65,35 +450,74 @@ public:
   void clear() { m_list.clear(); }
 
 private:
-  forwardList<T> m_list;
+  Container m_list;
 };
 
-template <typename T> class Priority_Queue {
+// heap in a Vector where every node has Arity children, top() is the
+// element no other compares less than under Compare (the smallest one for
+// the default std::less)
+// a 4-ary heap is half as deep as a binary one and its children share a
+// cache line, so pop reads fewer lines for one extra comparison per level
+// sifting moves a hole instead of swapping, each displaced element is
+// moved once and the new one is written once at the end
+template <typename T, typename Compare = std::less<T>, std::size_t Arity = 4>
+class Priority_Queue {
+  static_assert(Arity >= 2, "Priority_Queue needs at least two children.");
+
 public:
   Priority_Queue() = default;
+  explicit Priority_Queue(const Compare &compare) : m_compare(compare) {}
+
+  // take over values and order them in O(n), bottom-up
+  explicit Priority_Queue(Vector<T> values, const Compare &compare = Compare())
+      : m_vector(std::move(values)), m_compare(compare) {
+    _heapify();
+  }
+
   Priority_Queue(const Priority_Queue &other) = default;
   Priority_Queue(Priority_Queue &&other) = default;
   Priority_Queue &operator=(const Priority_Queue &other) = default;
   Priority_Queue &operator=(Priority_Queue &&other) = default;
   ~Priority_Queue() = default;
 
-  void push(const T &value) {
-    m_vector.push_back(value);
-    _heapify_up(m_vector.size() - 1);
-  }
+  void push(const T &value) { emplace(value); }
+  void push(T &&value) { emplace(std::move(value)); }
 
-  void push(T &&value) {
-    m_vector.push_back(std::move(value));
-    _heapify_up(m_vector.size() - 1);
+  template <typename... Args> void emplace(Args &&...args) {
+    m_vector.emplace_back(std::forward<Args>(args)...);
+    // lifted out of the last slot, which becomes the hole
+    T value = std::move(m_vector[m_vector.size() - 1]);
+    _sift_up(m_vector.size() - 1, std::move(value));
   }
 
   void pop() {
-    m_vector[0] = std::move(m_vector[m_vector.size() - 1]);
+    T last = std::move(m_vector[m_vector.size() - 1]);
     m_vector.pop_back();
-    _heapify_down(0);
+    if (!m_vector.empty()) {
+      _sift_to_leaf(std::move(last));
+    }
+  }
+
+  // push value and pop the top in one sift, returns what was popped; value
+  // itself comes straight back if it would be the new top
+  T push_pop(T value) {
+    if (m_vector.empty() || !m_compare(m_vector[0], value)) {
+      return value;
+    }
+    T top = std::move(m_vector[0]);
+    _sift_down(0, std::move(value));
+    return top;
   }
 
-  T top() const { return m_vector[0]; }
+  // pop the top and push value in one sift, returns what was popped; the
+  // queue must not be empty
+  T replace_top(T value) {
+    T top = std::move(m_vector[0]);
+    _sift_down(0, std::move(value));
+    return top;
+  }
+
+  const T &top() const { return m_vector[0]; }
 
   std::size_t size() const { return m_vector.size(); }
 
@@ -101,40 +525,263 @@ public:
 
   void clear() { m_vector.clear(); }
 
+  void reserve(std::size_t capacity) { m_vector.reserve(capacity); }
+
 private:
-  void _heapify_up(std::size_t i) {
-    if (i == 0) {
+  static std::size_t _parent(std::size_t i) { return (i - 1) / Arity; }
+  static std::size_t _first_child(std::size_t i) { return i * Arity + 1; }
+
+  // the hole moves up past every parent value goes before, then value fills
+  // it; value must not live in the heap
+  void _sift_up(std::size_t hole, T &&value) {
+    while (hole > 0) {
+      const std::size_t parent = _parent(hole);
+      if (!m_compare(value, m_vector[parent])) {
+        break;
+      }
+      m_vector[hole] = std::move(m_vector[parent]);
+      hole = parent;
+    }
+    m_vector[hole] = std::move(value);
+  }
+
+  // the hole moves down to the best child while that child goes before
+  // value, then value fills it; value must not live in the heap
+  void _sift_down(std::size_t hole, T &&value) {
+    const std::size_t size = m_vector.size();
+    for (;;) {
+      const std::size_t first = _first_child(hole);
+      if (first >= size) {
+        break;
+      }
+      const std::size_t last = std::min(first + Arity, size);
+      std::size_t best = first;
+      for (std::size_t child = first + 1; child < last; ++child) {
+        if (m_compare(m_vector[child], m_vector[best])) {
+          best = child;
+        }
+      }
+      if (!m_compare(m_vector[best], value)) {
+        break;
+      }
+      m_vector[hole] = std::move(m_vector[best]);
+      hole = best;
+    }
+    m_vector[hole] = std::move(value);
+  }
+
+  // refill the hole at the root after a pop: the last element nearly
+  // always belongs near the bottom again, so the hole goes all the way down
+  // along the best children without comparing against value, and value
+  // climbs back the few levels it has to; one comparison less per level
+  void _sift_to_leaf(T &&value) {
+    const std::size_t size = m_vector.size();
+    std::size_t hole = 0;
+    for (;;) {
+      const std::size_t first = _first_child(hole);
+      if (first >= size) {
+        break;
+      }
+      const std::size_t last = std::min(first + Arity, size);
+      std::size_t best = first;
+      for (std::size_t child = first + 1; child < last; ++child) {
+        if (m_compare(m_vector[child], m_vector[best])) {
+          best = child;
+        }
+      }
+      m_vector[hole] = std::move(m_vector[best]);
+      hole = best;
+    }
+    _sift_up(hole, std::move(value));
+  }
+
+  // sift down every node that has children, last one first
+  void _heapify() {
+    if (m_vector.size() < 2) {
       return;
     }
+    for (std::size_t i = _parent(m_vector.size() - 1) + 1; i-- > 0;) {
+      _sift_down(i, T(std::move(m_vector[i])));
+    }
+  }
+
+  Vector<T> m_vector;
+  [[no_unique_address]] Compare m_compare;
+};
+
+// Priority_Queue over dense integer handles in [0, n), each queued at most
+// once with a key that can change while it is queued
+// the heap holds (key, handle) entries, so comparisons never leave it, and
+// a side Vector maps each handle to its entry's position; it is written on
+// every move, which makes contains, key lookup and finding the entry to
+// re-sift O(1), and the heap only ever holds the live handles
+// top() is the handle whose key no other compares less than under Compare
+template <typename Key, typename Compare = std::less<Key>,
+          std::size_t Arity = 4>
+class Indexed_Priority_Queue {
+  static_assert(Arity >= 2,
+                "Indexed_Priority_Queue needs at least two children.");
+
+private:
+  struct Entry {
+    Key key;
+    std::size_t handle;
+  };
+
+  static constexpr std::size_t npos_ = static_cast<std::size_t>(-1);
+
+public:
+  Indexed_Priority_Queue() = default;
+  explicit Indexed_Priority_Queue(const Compare &compare)
+      : m_compare(compare) {}
+
+  // room for handles [0, handles) without growing the position table
+  explicit Indexed_Priority_Queue(std::size_t handles,
+                                  const Compare &compare = Compare())
+      : m_position(handles, npos_), m_compare(compare) {}
+
+  bool contains(std::size_t handle) const {
+    return handle < m_position.size() && m_position[handle] != npos_;
+  }
+
+  const Key &key(std::size_t handle) const {
+    return m_heap[_position(handle)].key;
+  }
+
+  // queue handle with key, it must not be queued already
+  void push(std::size_t handle, const Key &key) {
+    if (contains(handle)) {
+      throw std::invalid_argument("Handle already queued");
+    }
+    if (handle >= m_position.size()) {
+      m_position.resize(handle + 1, npos_);
+    }
+    m_heap.push_back(Entry{key, handle});
+    Entry entry = std::move(m_heap[m_heap.size() - 1]);
+    _sift_up(m_heap.size() - 1, std::move(entry));
+  }
+
+  // key must not go after the current one, the entry only moves up
+  void decrease_key(std::size_t handle, const Key &key) {
+    _sift_up(_position(handle), Entry{key, handle});
+  }
+
+  // key must not go before the current one, the entry only moves down
+  void increase_key(std::size_t handle, const Key &key) {
+    _sift_down(_position(handle), Entry{key, handle});
+  }
+
+  // either direction, or push if handle is not queued
+  void update(std::size_t handle, const Key &key) {
+    if (!contains(handle)) {
+      push(handle, key);
+    } else if (m_compare(key, m_heap[m_position[handle]].key)) {
+      decrease_key(handle, key);
+    } else {
+      increase_key(handle, key);
+    }
+  }
 
-    std::size_t parent = (i - 1) / 2;
-    if (m_vector[i] < m_vector[parent]) {
-      std::swap(m_vector[i], m_vector[parent]);
-      _heapify_up(parent);
+  // take handle out of the queue, false if it was not queued
+  bool erase(std::size_t handle) {
+    if (!contains(handle)) {
+      return false;
+    }
+    const std::size_t hole = m_position[handle];
+    m_position[handle] = npos_;
+    Entry last = std::move(m_heap[m_heap.size() - 1]);
+    m_heap.pop_back();
+    if (hole < m_heap.size()) {
+      // the last entry refills the hole and may have to go either way
+      if (hole > 0 && m_compare(last.key, m_heap[_parent(hole)].key)) {
+        _sift_up(hole, std::move(last));
+      } else {
+        _sift_down(hole, std::move(last));
+      }
     }
+    return true;
   }
 
-  void _heapify_down(std::size_t i) {
-    std::size_t left = 2 * i + 1;
-    std::size_t right = 2 * i + 2;
-    std::size_t smallest = i;
+  std::size_t top() const { return m_heap[0].handle; }
+  const Key &top_key() const { return m_heap[0].key; }
+
+  void pop() { erase(m_heap[0].handle); }
+
+  std::size_t size() const { return m_heap.size(); }
+
+  bool empty() const { return m_heap.empty(); }
 
-    if (left < m_vector.size() && m_vector[left] < m_vector[smallest]) {
-      smallest = left;
+  // the position table keeps its size, handles stay valid
+  void clear() {
+    for (std::size_t i = 0; i < m_heap.size(); ++i) {
+      m_position[m_heap[i].handle] = npos_;
     }
+    m_heap.clear();
+  }
 
-    if (right < m_vector.size() && m_vector[right] < m_vector[smallest]) {
-      smallest = right;
+  void reserve(std::size_t handles) {
+    m_heap.reserve(handles);
+    if (handles > m_position.size()) {
+      m_position.resize(handles, npos_);
     }
+  }
 
-    if (smallest != i) {
-      std::swap(m_vector[i], m_vector[smallest]);
-      _heapify_down(smallest);
+private:
+  static std::size_t _parent(std::size_t i) { return (i - 1) / Arity; }
+  static std::size_t _first_child(std::size_t i) { return i * Arity + 1; }
+
+  std::size_t _position(std::size_t handle) const {
+    if (!contains(handle)) {
+      throw std::out_of_range("Handle not queued");
     }
+    return m_position[handle];
   }
 
-  Vector<T> m_vector;
-  std::size_t m_size;
+  // write entry to position i and record where its handle now lives
+  void _place(std::size_t i, Entry &&entry) {
+    m_position[entry.handle] = i;
+    m_heap[i] = std::move(entry);
+  }
+
+  // as in Priority_Queue, with every moved entry's position updated
+  void _sift_up(std::size_t hole, Entry &&entry) {
+    while (hole > 0) {
+      const std::size_t parent = _parent(hole);
+      if (!m_compare(entry.key, m_heap[parent].key)) {
+        break;
+      }
+      _place(hole, std::move(m_heap[parent]));
+      hole = parent;
+    }
+    _place(hole, std::move(entry));
+  }
+
+  void _sift_down(std::size_t hole, Entry &&entry) {
+    const std::size_t size = m_heap.size();
+    for (;;) {
+      const std::size_t first = _first_child(hole);
+      if (first >= size) {
+        break;
+      }
+      const std::size_t last = std::min(first + Arity, size);
+      std::size_t best = first;
+      for (std::size_t child = first + 1; child < last; ++child) {
+        if (m_compare(m_heap[child].key, m_heap[best].key)) {
+          best = child;
+        }
+      }
+      if (!m_compare(m_heap[best].key, entry.key)) {
+        break;
+      }
+      _place(hole, std::move(m_heap[best]));
+      hole = best;
+    }
+    _place(hole, std::move(entry));
+  }
+
+  Vector<Entry> m_heap;
+  Vector<std::size_t> m_position;
+  [[no_unique_address]] Compare m_compare;
 };
 } // namespace Tiny
 
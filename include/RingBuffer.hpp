@@ -0,0 +1,385 @@
+#ifndef TINY_RING_BUFFER_HPP
+#define TINY_RING_BUFFER_HPP
+
+#include "Allocator.hpp"
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace Tiny {
+// what a push does when the buffer is full
+enum class RingPolicy {
+  Reject,    // leave the buffer alone and report failure
+  Overwrite, // drop the oldest element to make room
+  Grow,      // double the capacity, runtime capacity only
+};
+
+namespace Impl {
+// inline storage for a capacity fixed at compile time
+template <typename T, std::size_t Capacity> class RingStorage {
+public:
+  T *slots() { return reinterpret_cast<T *>(bytes_); }
+  const T *slots() const { return reinterpret_cast<const T *>(bytes_); }
+  static constexpr std::size_t capacity() { return Capacity; }
+
+private:
+  alignas(T) unsigned char bytes_[sizeof(T) * Capacity];
+};
+
+// heap storage for a capacity chosen at runtime
+template <typename T> class RingStorage<T, 0> {
+public:
+  T *slots() { return slots_; }
+  const T *slots() const { return slots_; }
+  std::size_t capacity() const { return capacity_; }
+
+  T *slots_ = nullptr;
+  std::size_t capacity_ = 0;
+};
+} // namespace Impl
+
+// FIFO queue in a circular buffer whose capacity is a power of two, so a
+// position is turned into a slot with a mask instead of a division
+// head and tail count every pop and push ever made, size is their
+// difference and never needs a separate count or a full flag
+// Capacity > 0 keeps the elements inline and must be a power of two,
+// Capacity == 0 allocates them, rounding the requested capacity up
+template <typename T, std::size_t Capacity = 0,
+          RingPolicy Policy = RingPolicy::Reject>
+class RingBuffer {
+  static_assert((Capacity & (Capacity - 1)) == 0,
+                "RingBuffer capacity must be a power of two.");
+  static_assert(Capacity != 0 || Policy != RingPolicy::Grow ||
+                    std::is_move_constructible_v<T>,
+                "A growing RingBuffer needs movable elements.");
+  static_assert(Capacity == 0 || Policy != RingPolicy::Grow,
+                "Only a runtime capacity RingBuffer can grow.");
+
+private:
+  static constexpr bool dynamic_ = Capacity == 0;
+  using alloc_traits = std::allocator_traits<Allocator<T>>;
+
+public:
+  RingBuffer() noexcept : head_(0), tail_(0) {}
+
+  // room for at least capacity elements, runtime capacity only
+  explicit RingBuffer(std::size_t capacity)
+    requires dynamic_
+      : RingBuffer() {
+    reserve(capacity);
+  }
+
+  RingBuffer(const RingBuffer &other) : RingBuffer() {
+    if constexpr (dynamic_) {
+      reserve(other.capacity());
+    }
+    for (std::size_t i = 0; i < other.size(); ++i) {
+      emplace_back(other[i]);
+    }
+  }
+
+  // a runtime capacity buffer hands over its storage, an inline one moves
+  // the elements
+  RingBuffer(RingBuffer &&other) noexcept(
+      dynamic_ || std::is_nothrow_move_constructible_v<T>)
+      : RingBuffer() {
+    _take(std::move(other));
+  }
+
+  ~RingBuffer() {
+    clear();
+    _release();
+  }
+
+  RingBuffer &operator=(const RingBuffer &other) {
+    if (this != &other) {
+      clear();
+      if constexpr (dynamic_) {
+        reserve(other.capacity());
+      }
+      for (std::size_t i = 0; i < other.size(); ++i) {
+        emplace_back(other[i]);
+      }
+    }
+    return *this;
+  }
+
+  RingBuffer &operator=(RingBuffer &&other) noexcept(
+      dynamic_ || std::is_nothrow_move_constructible_v<T>) {
+    if (this != &other) {
+      clear();
+      _release();
+      _take(std::move(other));
+    }
+    return *this;
+  }
+
+  // Element access, index 0 is the oldest element
+  T &operator[](std::size_t index) { return _slot(head_ + index); }
+  const T &operator[](std::size_t index) const {
+    return _slot(head_ + index);
+  }
+
+  T &at(std::size_t index) {
+    if (index >= size()) {
+      throw std::out_of_range("Index out of range");
+    }
+    return (*this)[index];
+  }
+
+  const T &at(std::size_t index) const {
+    if (index >= size()) {
+      throw std::out_of_range("Index out of range");
+    }
+    return (*this)[index];
+  }
+
+  T &front() { return _slot(head_); }
+  const T &front() const { return _slot(head_); }
+
+  T &back() { return _slot(tail_ - 1); }
+  const T &back() const { return _slot(tail_ - 1); }
+
+  // Capacity
+  std::size_t size() const { return tail_ - head_; }
+  std::size_t capacity() const { return storage_.capacity(); }
+  bool empty() const { return head_ == tail_; }
+  bool full() const { return size() == capacity(); }
+
+  // room for at least capacity elements, runtime capacity only
+  void reserve(std::size_t capacity)
+    requires dynamic_
+  {
+    if (capacity > this->capacity()) {
+      _reallocate(std::bit_ceil(capacity));
+    }
+  }
+
+  // Modifiers
+  // true if the value was stored and nothing was dropped: false means a
+  // Reject buffer was full and is unchanged, or an Overwrite buffer
+  // dropped its oldest element
+  template <typename... Args> bool emplace_back(Args &&...args) {
+    if (full()) {
+      if constexpr (Policy == RingPolicy::Reject) {
+        return false;
+      } else if constexpr (Policy == RingPolicy::Overwrite) {
+        if (capacity() == 0) {
+          return false;
+        }
+        // built first, args may refer to the element being replaced
+        _slot(tail_) = T(std::forward<Args>(args)...);
+        ++head_;
+        ++tail_;
+        return false;
+      } else {
+        _grow_emplace(std::forward<Args>(args)...);
+        return true;
+      }
+    }
+    ::new (static_cast<void *>(&_slot(tail_))) T(std::forward<Args>(args)...);
+    ++tail_;
+    return true;
+  }
+
+  bool push_back(const T &value) { return emplace_back(value); }
+  bool push_back(T &&value) { return emplace_back(std::move(value)); }
+
+  void pop_front() {
+    _slot(head_).~T();
+    ++head_;
+  }
+
+  void pop_back() {
+    --tail_;
+    _slot(tail_).~T();
+  }
+
+  void clear() {
+    if constexpr (!std::is_trivially_destructible_v<T>) {
+      while (!empty()) {
+        pop_front();
+      }
+    }
+    head_ = tail_ = 0;
+  }
+
+  // Bulk transfer, in at most two contiguous copies each
+  // append values, the policy decides what happens to the ones that do
+  // not fit; returns how many were stored, an Overwrite buffer always
+  // takes all of them but only keeps the last capacity()
+  std::size_t push_n(std::span<const T> values) {
+    std::size_t count = values.size();
+    if constexpr (Policy == RingPolicy::Reject) {
+      count = std::min(count, capacity() - size());
+    } else if constexpr (Policy == RingPolicy::Overwrite) {
+      if (count >= capacity()) {
+        clear();
+        _copy_in(values.data() + count - capacity(), capacity());
+        return count;
+      }
+      while (capacity() - size() < count) {
+        pop_front();
+      }
+    } else {
+      reserve(size() + count);
+    }
+    _copy_in(values.data(), count);
+    return count;
+  }
+
+  // move the oldest elements into out and pop them, returns how many
+  std::size_t pop_n(std::span<T> out) {
+    const std::size_t count = std::min(out.size(), size());
+    if (count == 0) {
+      return 0;
+    }
+    const std::size_t first = std::min(count, _run(head_));
+    T *src = &_slot(head_);
+    std::move(src, src + first, out.data());
+    std::destroy(src, src + first);
+    if (count > first) {
+      T *wrapped = storage_.slots();
+      std::move(wrapped, wrapped + count - first, out.data() + first);
+      std::destroy(wrapped, wrapped + count - first);
+    }
+    head_ += count;
+    return count;
+  }
+
+  void swap(RingBuffer &other) noexcept
+    requires dynamic_
+  {
+    std::swap(storage_, other.storage_);
+    std::swap(head_, other.head_);
+    std::swap(tail_, other.tail_);
+  }
+
+private:
+  T &_slot(std::size_t position) {
+    return storage_.slots()[position & (capacity() - 1)];
+  }
+
+  const T &_slot(std::size_t position) const {
+    return storage_.slots()[position & (capacity() - 1)];
+  }
+
+  // slots from position to the end of the storage
+  std::size_t _run(std::size_t position) const {
+    return capacity() - (position & (capacity() - 1));
+  }
+
+  // count values fit, copy them behind the tail
+  void _copy_in(const T *values, std::size_t count) {
+    if (count == 0) {
+      return;
+    }
+    const std::size_t first = std::min(count, _run(tail_));
+    std::uninitialized_copy(values, values + first, &_slot(tail_));
+    tail_ += first;
+    if (count > first) {
+      std::uninitialized_copy(values + first, values + count,
+                              storage_.slots());
+      tail_ += count - first;
+    }
+  }
+
+  // move the elements to a new allocation of capacity slots, they start
+  // at slot 0 afterwards
+  void _reallocate(std::size_t capacity) {
+    Allocator<T> alloc;
+    T *slots = alloc_traits::allocate(alloc, capacity);
+    _relocate_into(slots);
+    _install(slots, capacity);
+  }
+
+  // full and growing: the new element is built in the new storage before
+  // the old ones move, so args may refer to one of them
+  template <typename... Args> void _grow_emplace(Args &&...args) {
+    const std::size_t capacity = this->capacity() == 0
+                                     ? 1
+                                     : this->capacity() * 2;
+    Allocator<T> alloc;
+    T *slots = alloc_traits::allocate(alloc, capacity);
+    try {
+      ::new (static_cast<void *>(slots + size()))
+          T(std::forward<Args>(args)...);
+    } catch (...) {
+      alloc_traits::deallocate(alloc, slots, capacity);
+      throw;
+    }
+    try {
+      _relocate_into(slots);
+    } catch (...) {
+      slots[size()].~T();
+      alloc_traits::deallocate(alloc, slots, capacity);
+      throw;
+    }
+    const std::size_t count = size();
+    _install(slots, capacity);
+    tail_ = count + 1;
+  }
+
+  // move_if_noexcept every element into slots, on failure the copies are
+  // destroyed and the buffer is unchanged
+  void _relocate_into(T *slots) {
+    std::size_t done = 0;
+    try {
+      for (; done < size(); ++done) {
+        ::new (static_cast<void *>(slots + done))
+            T(std::move_if_noexcept((*this)[done]));
+      }
+    } catch (...) {
+      std::destroy(slots, slots + done);
+      throw;
+    }
+  }
+
+  // drop the old elements and storage, the relocated copies take over
+  void _install(T *slots, std::size_t capacity) {
+    const std::size_t count = size();
+    clear();
+    _release();
+    storage_.slots_ = slots;
+    storage_.capacity_ = capacity;
+    head_ = 0;
+    tail_ = count;
+  }
+
+  void _release() {
+    if constexpr (dynamic_) {
+      if (storage_.slots_ != nullptr) {
+        Allocator<T> alloc;
+        alloc_traits::deallocate(alloc, storage_.slots_, storage_.capacity_);
+        storage_.slots_ = nullptr;
+        storage_.capacity_ = 0;
+      }
+    }
+  }
+
+  // this is empty and has no storage
+  void _take(RingBuffer &&other) {
+    if constexpr (dynamic_) {
+      storage_ = std::exchange(other.storage_, {});
+      head_ = std::exchange(other.head_, 0);
+      tail_ = std::exchange(other.tail_, 0);
+    } else {
+      for (std::size_t i = 0; i < other.size(); ++i) {
+        emplace_back(std::move(other[i]));
+      }
+      other.clear();
+    }
+  }
+
+  Impl::RingStorage<T, Capacity> storage_;
+  std::size_t head_;
+  std::size_t tail_;
+};
+} // namespace Tiny
+
+#endif // TINY_RING_BUFFER_HPP
@@ -0,0 +1,493 @@
+#ifndef TINY_SIMD_HPP
+#define TINY_SIMD_HPP
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+// Search and reduction kernels over contiguous arithmetic data, usable with
+// anything that has data() and size(), e.g. Vector<T> and Array<T, N>.
+// On x86 the kernels are built once for SSE2 and once for AVX2 and picked at
+// runtime with CPUID, other targets get the 16 byte kernels the compiler
+// lowers to whatever vector unit they have. Needs GCC or Clang.
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define TINY_SIMD_X86 1
+#else
+#define TINY_SIMD_X86 0
+#endif
+
+namespace Tiny {
+namespace Simd {
+namespace Impl {
+// types the compiler can pack into vector registers
+template <typename T>
+inline constexpr bool vectorizable =
+    std::is_arithmetic_v<T> && !std::is_same_v<T, bool> &&
+    !std::is_same_v<T, long double>;
+
+template <typename T, std::size_t Bytes> struct Pack {
+  typedef T type __attribute__((vector_size(Bytes)));
+  static constexpr std::size_t lanes = Bytes / sizeof(T);
+};
+
+template <typename C>
+using element_t =
+    std::remove_cvref_t<decltype(*std::declval<const C &>().data())>;
+
+// Each kernel is a struct with a static apply<Bytes>, written once with GCC
+// vector extensions and inlined into the SSE2 and AVX2 entry points below.
+// Loads go through memcpy, so the data needs no particular alignment.
+
+struct Count {
+  template <std::size_t Bytes, typename T>
+  [[gnu::always_inline]] static inline std::size_t
+  apply(const T *data, std::size_t size, T value) {
+    using V = typename Pack<T, Bytes>::type;
+    using M = decltype(V{} == V{});
+    using Lane = std::remove_cvref_t<decltype(M{}[0])>;
+    constexpr std::size_t lanes = Pack<T, Bytes>::lanes;
+    // every match adds one to its lane, so narrow lanes are flushed before
+    // they can overflow
+    constexpr std::size_t flush =
+        static_cast<std::size_t>(std::numeric_limits<Lane>::max()) * lanes;
+
+    V needle;
+    for (std::size_t k = 0; k < lanes; ++k) {
+      needle[k] = value;
+    }
+
+    std::size_t result = 0;
+    std::size_t i = 0;
+    const std::size_t body = size - size % lanes;
+    while (i < body) {
+      const std::size_t end = body - i > flush ? i + flush : body;
+      M acc = {};
+      for (; i < end; i += lanes) {
+        V chunk;
+        std::memcpy(&chunk, data + i, Bytes);
+        acc -= chunk == needle;
+      }
+      for (std::size_t k = 0; k < lanes; ++k) {
+        result += static_cast<std::size_t>(acc[k]);
+      }
+    }
+    for (; i < size; ++i) {
+      result += data[i] == value;
+    }
+    return result;
+  }
+};
+
+struct Find {
+  template <std::size_t Bytes, typename T>
+  [[gnu::always_inline]] static inline std::size_t
+  apply(const T *data, std::size_t size, T value) {
+    using V = typename Pack<T, Bytes>::type;
+    using M = decltype(V{} == V{});
+    constexpr std::size_t lanes = Pack<T, Bytes>::lanes;
+
+    V needle;
+    for (std::size_t k = 0; k < lanes; ++k) {
+      needle[k] = value;
+    }
+
+    const M none = {};
+    std::size_t i = 0;
+    const std::size_t body = size - size % lanes;
+    for (; i < body; i += lanes) {
+      V chunk;
+      std::memcpy(&chunk, data + i, Bytes);
+      const M hit = chunk == needle;
+      if (std::memcmp(&hit, &none, Bytes) != 0) {
+        break;
+      }
+    }
+    for (; i < size; ++i) {
+      if (data[i] == value) {
+        return i;
+      }
+    }
+    return size;
+  }
+};
+
+struct Sum {
+  template <std::size_t Bytes, typename T>
+  [[gnu::always_inline]] static inline T apply(const T *data,
+                                               std::size_t size) {
+    // integers are added as unsigned so lanes wrap instead of overflowing
+    using A = typename std::conditional_t<std::is_integral_v<T>,
+                                          std::make_unsigned<T>,
+                                          std::type_identity<T>>::type;
+    using V = typename Pack<A, Bytes>::type;
+    constexpr std::size_t lanes = Pack<A, Bytes>::lanes;
+
+    // two accumulators hide the add latency
+    V acc0 = {}, acc1 = {};
+    std::size_t i = 0;
+    const std::size_t body = size - size % (2 * lanes);
+    for (; i < body; i += 2 * lanes) {
+      V chunk0, chunk1;
+      std::memcpy(&chunk0, data + i, Bytes);
+      std::memcpy(&chunk1, data + i + lanes, Bytes);
+      acc0 += chunk0;
+      acc1 += chunk1;
+    }
+    acc0 += acc1;
+
+    A result = A();
+    for (std::size_t k = 0; k < lanes; ++k) {
+      result += acc0[k];
+    }
+    for (; i < size; ++i) {
+      result += static_cast<A>(data[i]);
+    }
+    return static_cast<T>(result);
+  }
+};
+
+struct MinMax {
+  template <std::size_t Bytes, typename T>
+  [[gnu::always_inline]] static inline std::pair<T, T>
+  apply(const T *data, std::size_t size) {
+    using V = typename Pack<T, Bytes>::type;
+    constexpr std::size_t lanes = Pack<T, Bytes>::lanes;
+
+    V lo, hi;
+    for (std::size_t k = 0; k < lanes; ++k) {
+      lo[k] = data[0];
+      hi[k] = data[0];
+    }
+
+    std::size_t i = 0;
+    const std::size_t body = size - size % lanes;
+    for (; i < body; i += lanes) {
+      V chunk;
+      std::memcpy(&chunk, data + i, Bytes);
+      lo = chunk < lo ? chunk : lo;
+      hi = hi < chunk ? chunk : hi;
+    }
+
+    std::pair<T, T> result(lo[0], hi[0]);
+    for (std::size_t k = 1; k < lanes; ++k) {
+      result.first = lo[k] < result.first ? lo[k] : result.first;
+      result.second = result.second < hi[k] ? hi[k] : result.second;
+    }
+    for (; i < size; ++i) {
+      result.first = data[i] < result.first ? data[i] : result.first;
+      result.second = result.second < data[i] ? data[i] : result.second;
+    }
+    return result;
+  }
+};
+
+struct Min {
+  template <std::size_t Bytes, typename T>
+  [[gnu::always_inline]] static inline T apply(const T *data,
+                                               std::size_t size) {
+    using V = typename Pack<T, Bytes>::type;
+    constexpr std::size_t lanes = Pack<T, Bytes>::lanes;
+
+    V lo;
+    for (std::size_t k = 0; k < lanes; ++k) {
+      lo[k] = data[0];
+    }
+
+    std::size_t i = 0;
+    const std::size_t body = size - size % lanes;
+    for (; i < body; i += lanes) {
+      V chunk;
+      std::memcpy(&chunk, data + i, Bytes);
+      lo = chunk < lo ? chunk : lo;
+    }
+
+    T result = lo[0];
+    for (std::size_t k = 1; k < lanes; ++k) {
+      result = lo[k] < result ? lo[k] : result;
+    }
+    for (; i < size; ++i) {
+      result = data[i] < result ? data[i] : result;
+    }
+    return result;
+  }
+};
+
+struct Max {
+  template <std::size_t Bytes, typename T>
+  [[gnu::always_inline]] static inline T apply(const T *data,
+                                               std::size_t size) {
+    using V = typename Pack<T, Bytes>::type;
+    constexpr std::size_t lanes = Pack<T, Bytes>::lanes;
+
+    V hi;
+    for (std::size_t k = 0; k < lanes; ++k) {
+      hi[k] = data[0];
+    }
+
+    std::size_t i = 0;
+    const std::size_t body = size - size % lanes;
+    for (; i < body; i += lanes) {
+      V chunk;
+      std::memcpy(&chunk, data + i, Bytes);
+      hi = hi < chunk ? chunk : hi;
+    }
+
+    T result = hi[0];
+    for (std::size_t k = 1; k < lanes; ++k) {
+      result = result < hi[k] ? hi[k] : result;
+    }
+    for (; i < size; ++i) {
+      result = result < data[i] ? data[i] : result;
+    }
+    return result;
+  }
+};
+
+#if TINY_SIMD_X86
+template <typename Kernel, typename... Args>
+[[gnu::target("avx2")]] auto run_avx2(Args... args) {
+  return Kernel::template apply<32>(args...);
+}
+
+template <typename Kernel, typename... Args> auto run_sse2(Args... args) {
+  return Kernel::template apply<16>(args...);
+}
+
+inline bool has_avx2() {
+  static const bool avx2 = [] {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") != 0;
+  }();
+  return avx2;
+}
+
+// baseline x86-64 has no popcnt instruction, std::popcount then becomes a
+// bit trick, so the word loop is also built for the popcnt target
+[[gnu::target("popcnt")]] inline std::size_t
+popcount_hw(const std::uint64_t *words, std::size_t size) {
+  std::size_t result = 0;
+  for (std::size_t i = 0; i < size; ++i) {
+    result += std::popcount(words[i]);
+  }
+  return result;
+}
+
+inline bool has_popcnt() {
+  static const bool popcnt = [] {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("popcnt") != 0;
+  }();
+  return popcnt;
+}
+#endif
+
+// pick the widest kernel the CPU runs, SSE2 is always there on x86-64
+template <typename Kernel, typename... Args> auto dispatch(Args... args) {
+#if TINY_SIMD_X86
+  if (has_avx2()) {
+    return run_avx2<Kernel>(args...);
+  }
+  return run_sse2<Kernel>(args...);
+#else
+  return Kernel::template apply<16>(args...);
+#endif
+}
+
+inline void check_not_empty(std::size_t size) {
+  if (size == 0) {
+    throw std::out_of_range("Simd: empty range");
+  }
+}
+} // namespace Impl
+
+// ==== Scalar Kernels Begin Here ====
+// plain loops, used for types that do not fit in vector registers and as
+// the reference the vector kernels are measured against
+namespace Scalar {
+template <typename T>
+std::size_t find(const T *data, std::size_t size, const T &value) {
+  for (std::size_t i = 0; i < size; ++i) {
+    if (data[i] == value) {
+      return i;
+    }
+  }
+  return size;
+}
+
+template <typename T>
+std::size_t count(const T *data, std::size_t size, const T &value) {
+  std::size_t result = 0;
+  for (std::size_t i = 0; i < size; ++i) {
+    result += data[i] == value;
+  }
+  return result;
+}
+
+template <typename T> T sum(const T *data, std::size_t size) {
+  T result = T();
+  for (std::size_t i = 0; i < size; ++i) {
+    result += data[i];
+  }
+  return result;
+}
+
+template <typename T> T min(const T *data, std::size_t size) {
+  Impl::check_not_empty(size);
+  T result = data[0];
+  for (std::size_t i = 1; i < size; ++i) {
+    result = data[i] < result ? data[i] : result;
+  }
+  return result;
+}
+
+template <typename T> T max(const T *data, std::size_t size) {
+  Impl::check_not_empty(size);
+  T result = data[0];
+  for (std::size_t i = 1; i < size; ++i) {
+    result = result < data[i] ? data[i] : result;
+  }
+  return result;
+}
+
+template <typename T>
+std::pair<T, T> minmax(const T *data, std::size_t size) {
+  Impl::check_not_empty(size);
+  std::pair<T, T> result(data[0], data[0]);
+  for (std::size_t i = 1; i < size; ++i) {
+    result.first = data[i] < result.first ? data[i] : result.first;
+    result.second = result.second < data[i] ? data[i] : result.second;
+  }
+  return result;
+}
+} // namespace Scalar
+// ==== Scalar Kernels End Here ====
+
+// ==== Pointer Interface Begin Here ====
+// index of the first element equal to value, size if there is none
+template <typename T>
+std::size_t find(const T *data, std::size_t size, const T &value) {
+  if constexpr (Impl::vectorizable<T>) {
+    return Impl::dispatch<Impl::Find>(data, size, value);
+  } else {
+    return Scalar::find(data, size, value);
+  }
+}
+
+// number of elements equal to value
+template <typename T>
+std::size_t count(const T *data, std::size_t size, const T &value) {
+  if constexpr (Impl::vectorizable<T>) {
+    return Impl::dispatch<Impl::Count>(data, size, value);
+  } else {
+    return Scalar::count(data, size, value);
+  }
+}
+
+template <typename T>
+bool contains(const T *data, std::size_t size, const T &value) {
+  return find(data, size, value) != size;
+}
+
+// sum of all elements in T, integers wrap like the scalar loop
+// floating point sums are reassociated across lanes, so the last bits may
+// differ from a sequential loop
+template <typename T> T sum(const T *data, std::size_t size) {
+  if constexpr (Impl::vectorizable<T>) {
+    return Impl::dispatch<Impl::Sum>(data, size);
+  } else {
+    return Scalar::sum(data, size);
+  }
+}
+
+// min, max and minmax throw std::out_of_range on an empty range
+// the result is unspecified if the data contains NaN
+template <typename T> T min(const T *data, std::size_t size) {
+  if constexpr (Impl::vectorizable<T>) {
+    Impl::check_not_empty(size);
+    return Impl::dispatch<Impl::Min>(data, size);
+  } else {
+    return Scalar::min(data, size);
+  }
+}
+
+template <typename T> T max(const T *data, std::size_t size) {
+  if constexpr (Impl::vectorizable<T>) {
+    Impl::check_not_empty(size);
+    return Impl::dispatch<Impl::Max>(data, size);
+  } else {
+    return Scalar::max(data, size);
+  }
+}
+
+template <typename T>
+std::pair<T, T> minmax(const T *data, std::size_t size) {
+  if constexpr (Impl::vectorizable<T>) {
+    Impl::check_not_empty(size);
+    return Impl::dispatch<Impl::MinMax>(data, size);
+  } else {
+    return Scalar::minmax(data, size);
+  }
+}
+
+// number of set bits in size words
+inline std::size_t popcount(const std::uint64_t *words, std::size_t size) {
+#if TINY_SIMD_X86
+  if (Impl::has_popcnt()) {
+    return Impl::popcount_hw(words, size);
+  }
+#endif
+  std::size_t result = 0;
+  for (std::size_t i = 0; i < size; ++i) {
+    result += std::popcount(words[i]);
+  }
+  return result;
+}
+// ==== Pointer Interface End Here ====
+
+// ==== Container Interface Begin Here ====
+template <typename Container>
+std::size_t find(const Container &c, const Impl::element_t<Container> &value) {
+  return find(c.data(), c.size(), value);
+}
+
+template <typename Container>
+std::size_t count(const Container &c,
+                  const Impl::element_t<Container> &value) {
+  return count(c.data(), c.size(), value);
+}
+
+template <typename Container>
+bool contains(const Container &c, const Impl::element_t<Container> &value) {
+  return contains(c.data(), c.size(), value);
+}
+
+template <typename Container>
+Impl::element_t<Container> sum(const Container &c) {
+  return sum(c.data(), c.size());
+}
+
+template <typename Container>
+Impl::element_t<Container> min(const Container &c) {
+  return min(c.data(), c.size());
+}
+
+template <typename Container>
+Impl::element_t<Container> max(const Container &c) {
+  return max(c.data(), c.size());
+}
+
+template <typename Container>
+std::pair<Impl::element_t<Container>, Impl::element_t<Container>>
+minmax(const Container &c) {
+  return minmax(c.data(), c.size());
+}
+// ==== Container Interface End Here ====
+} // namespace Simd
+} // namespace Tiny
+
+#endif // TINY_SIMD_HPP
@@ -0,0 +1,576 @@
+#ifndef TINY_SMALL_VECTOR_HPP
+#define TINY_SMALL_VECTOR_HPP
+
+#include "Vector.hpp"
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace Tiny {
+// Vector with room for N elements inside the object itself
+// the heap is only touched once the size grows past N
+template <typename T, std::size_t N, typename Alloc = Allocator<T>>
+class SmallVector {
+  static_assert(N > 0, "SmallVector inline capacity must be greater than 0.");
+
+private:
+  using alloc_traits = std::allocator_traits<Alloc>;
+
+  static constexpr bool relocate_bitwise_ =
+      is_trivially_relocatable_v<T> &&
+      !requires(Alloc &alloc, T *ptr) {
+        alloc.construct(ptr, std::move(*ptr));
+      };
+
+public:
+  using iterator = T *;
+  using const_iterator = const T *;
+
+  SmallVector() noexcept(noexcept(Alloc()))
+      : data_(_inline()), size_(0), capacity_(N), alloc_() {}
+
+  explicit SmallVector(const Alloc &alloc) noexcept
+      : data_(_inline()), size_(0), capacity_(N), alloc_(alloc) {}
+
+  SmallVector(std::size_t size, const Alloc &alloc = Alloc())
+      : SmallVector(alloc) {
+    reserve(size);
+    _construct_tail(size);
+  }
+
+  SmallVector(std::size_t size, const T &value, const Alloc &alloc = Alloc())
+      : SmallVector(alloc) {
+    reserve(size);
+    _construct_tail(size, value);
+  }
+
+  SmallVector(const T *first, const T *last, const Alloc &alloc = Alloc())
+      : SmallVector(alloc) {
+    reserve(last - first);
+    _copy_tail(first, last);
+  }
+
+  SmallVector(const SmallVector &other)
+      : SmallVector(other.data_, other.data_ + other.size_,
+                    alloc_traits::select_on_container_copy_construction(
+                        other.alloc_)) {}
+
+  // a heap buffer is stolen, inline elements are relocated one by one
+  SmallVector(SmallVector &&other) noexcept(
+      std::is_nothrow_move_constructible_v<T>)
+      : SmallVector(other.alloc_) {
+    _take(other);
+  }
+
+  // adopt the heap buffer of a Vector without copying any element
+  template <typename Growth>
+  SmallVector(Vector<T, Alloc, Growth> &&other) noexcept
+      : SmallVector(other.alloc_) {
+    if (other.data_ != nullptr) {
+      data_ = std::exchange(other.data_, nullptr);
+      size_ = std::exchange(other.size_, 0);
+      capacity_ = std::exchange(other.capacity_, 0);
+    }
+  }
+
+  ~SmallVector() {
+    _destroy(0, size_);
+    _deallocate();
+  }
+
+  SmallVector &operator=(const SmallVector &other) {
+    if (this == &other) {
+      return *this;
+    }
+
+    _destroy(0, size_);
+    size_ = 0;
+
+    if constexpr (alloc_traits::propagate_on_container_copy_assignment::value) {
+      if (alloc_ != other.alloc_) {
+        _deallocate();
+      }
+      alloc_ = other.alloc_;
+    }
+
+    reserve(other.size_);
+    _copy_tail(other.data_, other.data_ + other.size_);
+    return *this;
+  }
+
+  SmallVector &operator=(SmallVector &&other) noexcept(
+      std::is_nothrow_move_constructible_v<T> &&
+      (alloc_traits::propagate_on_container_move_assignment::value ||
+       alloc_traits::is_always_equal::value)) {
+    if (this == &other) {
+      return *this;
+    }
+
+    clear();
+    if constexpr (alloc_traits::propagate_on_container_move_assignment::value) {
+      alloc_ = other.alloc_;
+    }
+    _take(other);
+    return *this;
+  }
+
+  T &operator[](std::size_t index) { return data_[index]; }
+  const T &operator[](std::size_t index) const { return data_[index]; }
+
+  // Capacity
+  std::size_t size() const { return size_; }
+  std::size_t capacity() const { return capacity_; }
+  bool empty() const { return size_ == 0; }
+  bool is_inline() const { return data_ == _inline(); }
+  static constexpr std::size_t inline_capacity() { return N; }
+
+  // Modifiers
+  void assign(std::size_t size, const T &value) {
+    *this = SmallVector(size, value, alloc_);
+  }
+
+  void assign(const T *first, const T *last) {
+    *this = SmallVector(first, last, alloc_);
+  }
+
+  // when growing, the new element is built in the new buffer before the old
+  // one goes away, so args may alias elements
+  template <typename... Args> void emplace_back(Args &&...args) {
+    if (size_ == capacity_) {
+      _grow_emplace(std::forward<Args>(args)...);
+      return;
+    }
+    alloc_traits::construct(alloc_, data_ + size_, std::forward<Args>(args)...);
+    ++size_;
+  }
+
+  // the value is built up front because args may refer to elements that are
+  // about to be shifted
+  template <typename... Args>
+  iterator emplace(const_iterator pos, Args &&...args) {
+    const std::size_t index = pos - data_;
+    if (index == size_) {
+      emplace_back(std::forward<Args>(args)...);
+      return data_ + index;
+    }
+
+    T value(std::forward<Args>(args)...);
+    return _insert_fill(index, 1, [&](T *dst) {
+      alloc_traits::construct(alloc_, dst, std::move(value));
+    });
+  }
+
+  void push_back(const T &value) { emplace_back(value); }
+  void push_back(T &&value) { emplace_back(std::move(value)); }
+
+  void pop_back() { alloc_traits::destroy(alloc_, data_ + --size_); }
+
+  iterator insert(const_iterator pos, const T &value) {
+    return emplace(pos, value);
+  }
+
+  iterator insert(const_iterator pos, T &&value) {
+    return emplace(pos, std::move(value));
+  }
+
+  iterator insert(const_iterator pos, std::size_t count, const T &value) {
+    const std::size_t index = pos - data_;
+    if (count == 0) {
+      return data_ + index;
+    }
+
+    // value may live inside the vector, keep a copy across the shift
+    const T copy(value);
+    return _insert_fill(index, count, [&](T *dst) {
+      std::size_t i = 0;
+      try {
+        for (; i < count; ++i) {
+          alloc_traits::construct(alloc_, dst + i, copy);
+        }
+      } catch (...) {
+        _destroy_range(dst, i);
+        throw;
+      }
+    });
+  }
+
+  // [first, last) must not point into this vector
+  template <std::forward_iterator ForwardIt>
+  iterator insert(const_iterator pos, ForwardIt first, ForwardIt last) {
+    const std::size_t index = pos - data_;
+    const std::size_t count = std::distance(first, last);
+    if (count == 0) {
+      return data_ + index;
+    }
+
+    return _insert_fill(index, count, [&](T *dst) {
+      std::size_t i = 0;
+      try {
+        for (ForwardIt it = first; i < count; ++it, ++i) {
+          alloc_traits::construct(alloc_, dst + i, *it);
+        }
+      } catch (...) {
+        _destroy_range(dst, i);
+        throw;
+      }
+    });
+  }
+
+  iterator erase(const_iterator pos) { return erase(pos, pos + 1); }
+
+  // the tail is shifted down once
+  iterator erase(const_iterator first, const_iterator last) {
+    const std::size_t index = first - data_;
+    const std::size_t count = last - first;
+    if (count == 0) {
+      return data_ + index;
+    }
+
+    const std::size_t tail = size_ - index - count;
+    _destroy(index, index + count);
+    size_ = index;
+    _move_tail(index + count, index, tail);
+    size_ = index + tail;
+    return data_ + index;
+  }
+
+  // destroy all elements and fall back to the inline buffer
+  void clear() {
+    _destroy(0, size_);
+    size_ = 0;
+    _deallocate();
+  }
+
+  void resize(std::size_t size) {
+    if (size < size_) {
+      _destroy(size, size_);
+      size_ = size;
+    } else if (size > size_) {
+      reserve(size);
+      _construct_tail(size);
+    }
+  }
+
+  void resize(std::size_t size, const T &value) {
+    if (size < size_) {
+      _destroy(size, size_);
+      size_ = size;
+    } else if (size > size_) {
+      reserve(size);
+      _construct_tail(size, value);
+    }
+  }
+
+  void reserve(std::size_t capacity) {
+    if (capacity <= capacity_) {
+      return;
+    }
+
+    T *new_data = alloc_traits::allocate(alloc_, capacity);
+    try {
+      _relocate(data_, new_data, size_);
+    } catch (...) {
+      alloc_traits::deallocate(alloc_, new_data, capacity);
+      throw;
+    }
+    _relocate_done(data_, size_);
+    _deallocate();
+    data_ = new_data;
+    capacity_ = capacity;
+  }
+
+  // shrink a heap buffer down to size, or back into the inline one when the
+  // elements fit there
+  void shrink_to_fit() {
+    if (is_inline() || capacity_ == size_) {
+      return;
+    }
+
+    const bool to_inline = size_ <= N;
+    const std::size_t capacity = to_inline ? N : size_;
+    T *new_data = to_inline ? _inline() : alloc_traits::allocate(alloc_, size_);
+    try {
+      _relocate(data_, new_data, size_);
+    } catch (...) {
+      if (!to_inline) {
+        alloc_traits::deallocate(alloc_, new_data, capacity);
+      }
+      throw;
+    }
+    _relocate_done(data_, size_);
+    _deallocate();
+    data_ = new_data;
+    capacity_ = capacity;
+  }
+
+  void swap(SmallVector &other) {
+    SmallVector tmp(std::move(other));
+    other = std::move(*this);
+    *this = std::move(tmp);
+  }
+
+  // hand the elements over to a Vector, a heap buffer moves without copying
+  template <typename Growth = GrowDouble>
+  Vector<T, Alloc, Growth> to_vector() && {
+    Vector<T, Alloc, Growth> vec(alloc_);
+    if (is_inline()) {
+      vec.reserve(size_);
+      _relocate(data_, vec.data_, size_);
+      _relocate_done(data_, size_);
+      vec.size_ = std::exchange(size_, 0);
+    } else {
+      vec.data_ = std::exchange(data_, _inline());
+      vec.size_ = std::exchange(size_, 0);
+      vec.capacity_ = std::exchange(capacity_, N);
+    }
+    return vec;
+  }
+
+  // Element access
+  T &at(std::size_t index) {
+    if (index >= size_) {
+      throw std::out_of_range("Index out of range");
+    }
+    return data_[index];
+  }
+
+  const T &at(std::size_t index) const {
+    if (index >= size_) {
+      throw std::out_of_range("Index out of range");
+    }
+    return data_[index];
+  }
+
+  T &front() { return data_[0]; }
+  const T &front() const { return data_[0]; }
+
+  T &back() { return data_[size_ - 1]; }
+  const T &back() const { return data_[size_ - 1]; }
+
+  T *data() { return data_; }
+  const T *data() const { return data_; }
+
+  // Iterators
+  iterator begin() { return data_; }
+  const_iterator begin() const { return data_; }
+  const_iterator cbegin() const { return data_; }
+  iterator end() { return data_ + size_; }
+  const_iterator end() const { return data_ + size_; }
+  const_iterator cend() const { return data_ + size_; }
+
+  Alloc get_allocator() const { return alloc_; }
+
+private:
+  T *_inline() { return reinterpret_cast<T *>(inline_); }
+  const T *_inline() const { return reinterpret_cast<const T *>(inline_); }
+
+  // release a heap buffer and point back at the inline one
+  void _deallocate() {
+    if (!is_inline()) {
+      alloc_traits::deallocate(alloc_, data_, capacity_);
+      data_ = _inline();
+      capacity_ = N;
+    }
+  }
+
+  void _destroy(std::size_t first, std::size_t last) {
+    _destroy_range(data_ + first, last - first);
+  }
+
+  void _destroy_range(T *first, std::size_t count) {
+    for (std::size_t i = 0; i < count; ++i) {
+      alloc_traits::destroy(alloc_, first + i);
+    }
+  }
+
+  template <typename... Args>
+  void _construct_tail(std::size_t size, const Args &...args) {
+    for (; size_ < size; ++size_) {
+      alloc_traits::construct(alloc_, data_ + size_, args...);
+    }
+  }
+
+  void _copy_tail(const T *first, const T *last) {
+    for (; first != last; ++first, ++size_) {
+      alloc_traits::construct(alloc_, data_ + size_, *first);
+    }
+  }
+
+  // build count elements from src into raw storage at dst, same rules as
+  // Vector::reserve: memcpy when bitwise relocation is safe, else
+  // move_if_noexcept with rollback; src stays alive until _relocate_done
+  void _relocate(T *src, T *dst, std::size_t count) {
+    if constexpr (relocate_bitwise_) {
+      if (count != 0) {
+        std::memcpy(static_cast<void *>(dst), static_cast<const void *>(src),
+                    count * sizeof(T));
+      }
+    } else {
+      std::size_t i = 0;
+      try {
+        for (; i < count; ++i) {
+          alloc_traits::construct(alloc_, dst + i,
+                                  std::move_if_noexcept(src[i]));
+        }
+      } catch (...) {
+        for (std::size_t j = 0; j < i; ++j) {
+          alloc_traits::destroy(alloc_, dst + j);
+        }
+        throw;
+      }
+    }
+  }
+
+  // destroy the moved-from sources once a relocation has fully succeeded
+  void _relocate_done(T *src, std::size_t count) {
+    if constexpr (!relocate_bitwise_) {
+      for (std::size_t i = 0; i < count; ++i) {
+        alloc_traits::destroy(alloc_, src + i);
+      }
+    }
+  }
+
+  // emplace_back on a full buffer: the element is built first, then the old
+  // elements are relocated and the old buffer is released
+  template <typename... Args> void _grow_emplace(Args &&...args) {
+    const std::size_t capacity = _grow_capacity(size_ + 1);
+    T *new_data = alloc_traits::allocate(alloc_, capacity);
+    try {
+      alloc_traits::construct(alloc_, new_data + size_,
+                              std::forward<Args>(args)...);
+      try {
+        _relocate(data_, new_data, size_);
+      } catch (...) {
+        alloc_traits::destroy(alloc_, new_data + size_);
+        throw;
+      }
+    } catch (...) {
+      alloc_traits::deallocate(alloc_, new_data, capacity);
+      throw;
+    }
+    _relocate_done(data_, size_);
+    _deallocate();
+    data_ = new_data;
+    capacity_ = capacity;
+    ++size_;
+  }
+
+  std::size_t _grow_capacity(std::size_t size) const {
+    return capacity_ * 2 < size ? size : capacity_ * 2;
+  }
+
+  // relocate count elements from data_ + from to raw storage at data_ + to
+  // the ranges may overlap; a throwing move destroys the whole tail, so
+  // callers shrink size_ to the part that stays valid before calling
+  void _move_tail(std::size_t from, std::size_t to, std::size_t count) {
+    if (count == 0 || from == to) {
+      return;
+    }
+
+    if constexpr (relocate_bitwise_) {
+      std::memmove(static_cast<void *>(data_ + to),
+                   static_cast<const void *>(data_ + from), count * sizeof(T));
+    } else {
+      // walk away from the overlap: back to front when moving up
+      const bool up = to > from;
+      std::size_t done = 0;
+      try {
+        for (; done < count; ++done) {
+          std::size_t i = up ? count - 1 - done : done;
+          alloc_traits::construct(alloc_, data_ + to + i,
+                                  std::move(data_[from + i]));
+          alloc_traits::destroy(alloc_, data_ + from + i);
+        }
+      } catch (...) {
+        for (std::size_t i = 0; i < count; ++i) {
+          bool moved = up ? i > count - 1 - done : i < done;
+          alloc_traits::destroy(alloc_, data_ + (moved ? to : from) + i);
+        }
+        throw;
+      }
+    }
+  }
+
+  // open a gap of count raw slots at index and let fill(dst) construct them
+  // fill must destroy whatever it built before rethrowing
+  // when the buffer is full the gap is built in the new buffer first, so
+  // fill may still read from the old elements
+  template <typename Fill>
+  T *_insert_fill(std::size_t index, std::size_t count, Fill fill) {
+    const std::size_t tail = size_ - index;
+
+    if (size_ + count > capacity_) {
+      const std::size_t capacity = _grow_capacity(size_ + count);
+      T *new_data = alloc_traits::allocate(alloc_, capacity);
+      try {
+        fill(new_data + index);
+        try {
+          _relocate(data_, new_data, index);
+          try {
+            _relocate(data_ + index, new_data + index + count, tail);
+          } catch (...) {
+            if constexpr (!relocate_bitwise_) {
+              _destroy_range(new_data, index);
+            }
+            throw;
+          }
+        } catch (...) {
+          _destroy_range(new_data + index, count);
+          throw;
+        }
+      } catch (...) {
+        alloc_traits::deallocate(alloc_, new_data, capacity);
+        throw;
+      }
+      _relocate_done(data_, size_);
+      _deallocate();
+      data_ = new_data;
+      capacity_ = capacity;
+      size_ += count;
+      return data_ + index;
+    }
+
+    size_ = index;
+    _move_tail(index, index + count, tail);
+    try {
+      fill(data_ + index);
+    } catch (...) {
+      _move_tail(index + count, index, tail);
+      size_ = index + tail;
+      throw;
+    }
+    size_ = index + count + tail;
+    return data_ + index;
+  }
+
+  // take everything from other, which is left empty on its inline buffer
+  // expects *this to be empty and inline
+  void _take(SmallVector &other) {
+    if (!other.is_inline() && alloc_ == other.alloc_) {
+      data_ = std::exchange(other.data_, other._inline());
+      size_ = std::exchange(other.size_, 0);
+      capacity_ = std::exchange(other.capacity_, N);
+      return;
+    }
+
+    reserve(other.size_);
+    for (; size_ < other.size_; ++size_) {
+      alloc_traits::construct(alloc_, data_ + size_,
+                              std::move(other.data_[size_]));
+    }
+    other.clear();
+  }
+
+  T *data_;
+  std::size_t size_;
+  std::size_t capacity_;
+  [[no_unique_address]] Alloc alloc_;
+  alignas(T) unsigned char inline_[sizeof(T) * N];
+};
+} // namespace Tiny
+
+#endif // TINY_SMALL_VECTOR_HPP
@@ -0,0 +1,302 @@
+#ifndef TINY_SOA_VECTOR_HPP
+#define TINY_SOA_VECTOR_HPP
+
+#include "Allocator.hpp"
+#include "Vector.hpp"
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace Tiny {
+// struct-of-arrays table: every field lives in its own contiguous column,
+// so a loop over one field streams only that field through the cache
+// all columns share one allocation, each starting on an alignment boundary
+// rows are handed out as tuples of references, e.g.
+//   auto [id, score] = table[i];
+// fields must be nothrow move constructible so growth cannot fail halfway
+template <typename... Fields> class SoAVector {
+  static_assert(sizeof...(Fields) > 0, "SoAVector needs at least one field.");
+  static_assert((std::is_nothrow_move_constructible_v<Fields> && ...),
+                "SoAVector fields must be nothrow move constructible.");
+
+public:
+  static constexpr std::size_t alignment = 64;
+  static constexpr std::size_t field_count = sizeof...(Fields);
+
+  template <std::size_t I>
+  using field_type = std::tuple_element_t<I, std::tuple<Fields...>>;
+
+  using value_type = std::tuple<Fields...>;
+  using reference = std::tuple<Fields &...>;
+  using const_reference = std::tuple<const Fields &...>;
+
+private:
+  static_assert(((alignof(Fields) <= alignment) && ...),
+                "SoAVector field alignment too big.");
+
+  using Alloc = AlignedAllocator<unsigned char, alignment, false>;
+  using alloc_traits = std::allocator_traits<Alloc>;
+  using Columns = std::tuple<Fields *...>;
+
+public:
+  SoAVector() noexcept
+      : columns_(), buffer_(nullptr), size_(0), capacity_(0) {}
+
+  explicit SoAVector(std::size_t size) : SoAVector() { resize(size); }
+
+  SoAVector(const SoAVector &other) : SoAVector() {
+    reserve(other.size_);
+    for (std::size_t i = 0; i < other.size_; ++i) {
+      std::apply([this](const Fields &...values) { emplace_back(values...); },
+                 other[i]);
+    }
+  }
+
+  SoAVector(SoAVector &&other) noexcept
+      : columns_(std::exchange(other.columns_, Columns())),
+        buffer_(std::exchange(other.buffer_, nullptr)),
+        size_(std::exchange(other.size_, 0)),
+        capacity_(std::exchange(other.capacity_, 0)) {}
+
+  ~SoAVector() {
+    clear();
+    _deallocate();
+  }
+
+  SoAVector &operator=(const SoAVector &other) {
+    if (this != &other) {
+      SoAVector tmp(other);
+      swap(tmp);
+    }
+    return *this;
+  }
+
+  SoAVector &operator=(SoAVector &&other) noexcept {
+    if (this != &other) {
+      clear();
+      _deallocate();
+      swap(other);
+    }
+    return *this;
+  }
+
+  // row i as a tuple of references into the columns
+  reference operator[](std::size_t index) {
+    return _row<reference>(*this, index,
+                           std::index_sequence_for<Fields...>());
+  }
+
+  const_reference operator[](std::size_t index) const {
+    return _row<const_reference>(*this, index,
+                                 std::index_sequence_for<Fields...>());
+  }
+
+  // Capacity
+  std::size_t size() const { return size_; }
+  std::size_t capacity() const { return capacity_; }
+  bool empty() const { return size_ == 0; }
+
+  // one allocation for all columns, every column is moved over
+  void reserve(std::size_t capacity) {
+    if (capacity <= capacity_) {
+      return;
+    }
+
+    unsigned char *buffer = alloc_traits::allocate(alloc_, _bytes(capacity));
+    Columns columns = _layout(buffer, capacity);
+    _each_column([&](auto I) {
+      using F = field_type<I>;
+      F *src = std::get<I>(columns_);
+      F *dst = std::get<I>(columns);
+      if constexpr (is_trivially_relocatable_v<F>) {
+        if (size_ != 0) {
+          std::memcpy(static_cast<void *>(dst),
+                      static_cast<const void *>(src), size_ * sizeof(F));
+        }
+      } else {
+        for (std::size_t i = 0; i < size_; ++i) {
+          std::construct_at(dst + i, std::move(src[i]));
+          std::destroy_at(src + i);
+        }
+      }
+    });
+
+    _deallocate();
+    columns_ = columns;
+    buffer_ = buffer;
+    capacity_ = capacity;
+  }
+
+  // Modifiers
+  // one argument per field, in field order
+  template <typename... Args>
+    requires(sizeof...(Args) == sizeof...(Fields))
+  void emplace_back(Args &&...args) {
+    if (size_ == capacity_) {
+      // args may point into the columns, build the row before growing
+      value_type row(std::forward<Args>(args)...);
+      reserve(GrowDouble::grow(capacity_));
+      _construct_row(std::move(row));
+      return;
+    }
+    _construct_row(std::forward_as_tuple(std::forward<Args>(args)...));
+  }
+
+  void push_back(const value_type &row) {
+    std::apply([this](const Fields &...values) { emplace_back(values...); },
+               row);
+  }
+
+  void push_back(value_type &&row) {
+    std::apply(
+        [this](Fields &...values) { emplace_back(std::move(values)...); },
+        row);
+  }
+
+  void pop_back() {
+    --size_;
+    _each_column(
+        [&](auto I) { std::destroy_at(std::get<I>(columns_) + size_); });
+  }
+
+  // destroy all rows, the buffer is kept
+  void clear() {
+    _each_column([&](auto I) {
+      std::destroy(std::get<I>(columns_), std::get<I>(columns_) + size_);
+    });
+    size_ = 0;
+  }
+
+  // new rows are value initialized
+  void resize(std::size_t size) {
+    while (size_ > size) {
+      pop_back();
+    }
+    reserve(size);
+    while (size_ < size) {
+      emplace_back(Fields()...);
+    }
+  }
+
+  void swap(SoAVector &other) noexcept {
+    std::swap(columns_, other.columns_);
+    std::swap(buffer_, other.buffer_);
+    std::swap(size_, other.size_);
+    std::swap(capacity_, other.capacity_);
+  }
+
+  // Element access
+  reference at(std::size_t index) {
+    if (index >= size_) {
+      throw std::out_of_range("Index out of range");
+    }
+    return (*this)[index];
+  }
+
+  const_reference at(std::size_t index) const {
+    if (index >= size_) {
+      throw std::out_of_range("Index out of range");
+    }
+    return (*this)[index];
+  }
+
+  reference front() { return (*this)[0]; }
+  const_reference front() const { return (*this)[0]; }
+  reference back() { return (*this)[size_ - 1]; }
+  const_reference back() const { return (*this)[size_ - 1]; }
+
+  // Columns
+  // column I as a contiguous span of size() elements aligned to alignment
+  template <std::size_t I> std::span<field_type<I>> column() {
+    return std::span<field_type<I>>(std::get<I>(columns_), size_);
+  }
+
+  template <std::size_t I> std::span<const field_type<I>> column() const {
+    return std::span<const field_type<I>>(std::get<I>(columns_), size_);
+  }
+
+  template <std::size_t I> field_type<I> *data() {
+    return std::get<I>(columns_);
+  }
+
+  template <std::size_t I> const field_type<I> *data() const {
+    return std::get<I>(columns_);
+  }
+
+private:
+  static constexpr std::size_t _round_up(std::size_t bytes) {
+    return (bytes + alignment - 1) / alignment * alignment;
+  }
+
+  static std::size_t _bytes(std::size_t capacity) {
+    return (_round_up(capacity * sizeof(Fields)) + ...);
+  }
+
+  // carve one buffer into aligned columns, in field order
+  static Columns _layout(unsigned char *buffer, std::size_t capacity) {
+    std::size_t offset = 0;
+    auto next = [&](auto *type) {
+      using F = std::remove_pointer_t<decltype(type)>;
+      F *column = reinterpret_cast<F *>(buffer + offset);
+      offset += _round_up(capacity * sizeof(F));
+      return column;
+    };
+    // braced init evaluates left to right
+    return Columns{next(static_cast<Fields *>(nullptr))...};
+  }
+
+  template <typename F> void _each_column(F f) {
+    [&]<std::size_t... I>(std::index_sequence<I...>) {
+      (f(std::integral_constant<std::size_t, I>()), ...);
+    }(std::index_sequence_for<Fields...>());
+  }
+
+  template <typename Row, typename Self, std::size_t... I>
+  static Row _row(Self &self, std::size_t index, std::index_sequence<I...>) {
+    return Row(std::get<I>(self.columns_)[index]...);
+  }
+
+  // construct one row at size_ from a tuple of arguments
+  // a throwing field destroys the fields already built
+  template <typename Tuple> void _construct_row(Tuple &&values) {
+    std::size_t built = 0;
+    try {
+      _each_column([&](auto I) {
+        std::construct_at(std::get<I>(columns_) + size_,
+                          std::get<I>(std::forward<Tuple>(values)));
+        ++built;
+      });
+    } catch (...) {
+      _each_column([&](auto I) {
+        if (I < built) {
+          std::destroy_at(std::get<I>(columns_) + size_);
+        }
+      });
+      throw;
+    }
+    ++size_;
+  }
+
+  void _deallocate() {
+    if (buffer_ != nullptr) {
+      alloc_traits::deallocate(alloc_, buffer_, _bytes(capacity_));
+    }
+    columns_ = Columns();
+    buffer_ = nullptr;
+    capacity_ = 0;
+  }
+
+  Columns columns_;
+  unsigned char *buffer_;
+  std::size_t size_;
+  std::size_t capacity_;
+  [[no_unique_address]] Alloc alloc_;
+};
+} // namespace Tiny
+
+#endif // TINY_SOA_VECTOR_HPP
@@ -0,0 +1,382 @@
+#ifndef TINY_STABLE_VECTOR_HPP
+#define TINY_STABLE_VECTOR_HPP
+
+#include "Allocator.hpp"
+#include <algorithm>
+#include <bit>
+#include <compare>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace Tiny {
+// Vector made of blocks that double in size: FirstBlock, 2 * FirstBlock,
+// 4 * FirstBlock, ...
+// growing only adds a block, elements never move, so pointers and
+// references stay valid until their element is popped or cleared
+// index i lives in block bit_width(i + FirstBlock) - bit_width(FirstBlock),
+// found with one count-leading-zeros, at offset (i + FirstBlock) minus the
+// top bit
+template <typename T, typename Alloc = Allocator<T>,
+          std::size_t FirstBlock = 16>
+class StableVector {
+  static_assert(FirstBlock > 0 && (FirstBlock & (FirstBlock - 1)) == 0,
+                "StableVector first block size must be a power of two.");
+
+private:
+  using alloc_traits = std::allocator_traits<Alloc>;
+
+  static constexpr std::size_t first_shift_ = std::bit_width(FirstBlock) - 1;
+  // enough blocks to address every size_t index
+  static constexpr std::size_t max_blocks_ = 64 - first_shift_;
+
+  template <bool Const> class Iterator {
+    using owner_pointer =
+        std::conditional_t<Const, const StableVector *, StableVector *>;
+
+  public:
+    using iterator_category = std::random_access_iterator_tag;
+    using iterator_concept = std::random_access_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using pointer = std::conditional_t<Const, const T *, T *>;
+    using reference = std::conditional_t<Const, const T &, T &>;
+
+    Iterator() = default;
+    Iterator(owner_pointer owner, std::size_t index)
+        : owner_(owner), index_(index) {}
+    // iterator converts to const_iterator
+    template <bool C>
+    Iterator(const Iterator<C> &other)
+      requires(Const && !C)
+        : owner_(other.owner_), index_(other.index_) {}
+
+    reference operator*() const { return (*owner_)[index_]; }
+    pointer operator->() const { return &(*owner_)[index_]; }
+    reference operator[](difference_type n) const {
+      return (*owner_)[index_ + n];
+    }
+
+    Iterator &operator++() {
+      ++index_;
+      return *this;
+    }
+    Iterator operator++(int) {
+      Iterator tmp = *this;
+      ++index_;
+      return tmp;
+    }
+    Iterator &operator--() {
+      --index_;
+      return *this;
+    }
+    Iterator operator--(int) {
+      Iterator tmp = *this;
+      --index_;
+      return tmp;
+    }
+    Iterator &operator+=(difference_type n) {
+      index_ += n;
+      return *this;
+    }
+    Iterator &operator-=(difference_type n) {
+      index_ -= n;
+      return *this;
+    }
+
+    friend Iterator operator+(Iterator it, difference_type n) {
+      return it += n;
+    }
+    friend Iterator operator+(difference_type n, Iterator it) {
+      return it += n;
+    }
+    friend Iterator operator-(Iterator it, difference_type n) {
+      return it -= n;
+    }
+    friend difference_type operator-(const Iterator &lhs,
+                                     const Iterator &rhs) {
+      return static_cast<difference_type>(lhs.index_ - rhs.index_);
+    }
+    friend bool operator==(const Iterator &lhs, const Iterator &rhs) {
+      return lhs.index_ == rhs.index_;
+    }
+    friend auto operator<=>(const Iterator &lhs, const Iterator &rhs) {
+      return lhs.index_ <=> rhs.index_;
+    }
+
+  private:
+    owner_pointer owner_ = nullptr;
+    std::size_t index_ = 0;
+
+    friend class Iterator<true>;
+  };
+
+public:
+  using iterator = Iterator<false>;
+  using const_iterator = Iterator<true>;
+
+  StableVector() noexcept(noexcept(Alloc())) : StableVector(Alloc()) {}
+
+  explicit StableVector(const Alloc &alloc) noexcept
+      : blocks_{}, block_count_(0), size_(0), alloc_(alloc) {}
+
+  StableVector(std::size_t size, const Alloc &alloc = Alloc())
+      : StableVector(alloc) {
+    resize(size);
+  }
+
+  StableVector(std::size_t size, const T &value, const Alloc &alloc = Alloc())
+      : StableVector(alloc) {
+    resize(size, value);
+  }
+
+  StableVector(const StableVector &other)
+      : StableVector(alloc_traits::select_on_container_copy_construction(
+            other.alloc_)) {
+    _copy_from(other);
+  }
+
+  // the blocks are handed over, no element moves
+  StableVector(StableVector &&other) noexcept
+      : block_count_(std::exchange(other.block_count_, 0)),
+        size_(std::exchange(other.size_, 0)), alloc_(std::move(other.alloc_)) {
+    for (std::size_t b = 0; b < max_blocks_; ++b) {
+      blocks_[b] = std::exchange(other.blocks_[b], nullptr);
+    }
+  }
+
+  ~StableVector() {
+    clear();
+    _release_blocks(0);
+  }
+
+  StableVector &operator=(const StableVector &other) {
+    if (this == &other) {
+      return *this;
+    }
+
+    clear();
+    if constexpr (alloc_traits::propagate_on_container_copy_assignment::value) {
+      if (alloc_ != other.alloc_) {
+        _release_blocks(0);
+      }
+      alloc_ = other.alloc_;
+    }
+    _copy_from(other);
+    return *this;
+  }
+
+  StableVector &operator=(StableVector &&other) noexcept(
+      alloc_traits::propagate_on_container_move_assignment::value ||
+      alloc_traits::is_always_equal::value) {
+    if (this == &other) {
+      return *this;
+    }
+
+    clear();
+    constexpr bool propagate =
+        alloc_traits::propagate_on_container_move_assignment::value;
+    if (propagate || alloc_ == other.alloc_) {
+      _release_blocks(0);
+      if constexpr (propagate) {
+        alloc_ = std::move(other.alloc_);
+      }
+      swap(other);
+      return *this;
+    }
+
+    // foreign allocator, elements have to move one by one
+    reserve(other.size_);
+    for (std::size_t i = 0; i < other.size_; ++i) {
+      emplace_back(std::move(other[i]));
+    }
+    other.clear();
+    return *this;
+  }
+
+  T &operator[](std::size_t index) {
+    const std::size_t n = index + FirstBlock;
+    const std::size_t b = std::bit_width(n) - 1;
+    return blocks_[b - first_shift_][n - (std::size_t(1) << b)];
+  }
+
+  const T &operator[](std::size_t index) const {
+    const std::size_t n = index + FirstBlock;
+    const std::size_t b = std::bit_width(n) - 1;
+    return blocks_[b - first_shift_][n - (std::size_t(1) << b)];
+  }
+
+  // Capacity
+  std::size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+  // total size of the allocated blocks
+  std::size_t capacity() const { return _block_start(block_count_); }
+
+  // allocate blocks up front, nothing already stored moves
+  void reserve(std::size_t capacity) {
+    while (this->capacity() < capacity) {
+      _add_block();
+    }
+  }
+
+  // free blocks that hold no element
+  void shrink_to_fit() {
+    std::size_t used = 0;
+    while (_block_start(used) < size_) {
+      ++used;
+    }
+    _release_blocks(used);
+  }
+
+  // Modifiers
+  template <typename... Args> void emplace_back(Args &&...args) {
+    if (size_ == capacity()) {
+      _add_block();
+    }
+    alloc_traits::construct(alloc_, &(*this)[size_],
+                            std::forward<Args>(args)...);
+    ++size_;
+  }
+
+  void push_back(const T &value) { emplace_back(value); }
+  void push_back(T &&value) { emplace_back(std::move(value)); }
+
+  void pop_back() { alloc_traits::destroy(alloc_, &(*this)[--size_]); }
+
+  // destroy all elements, blocks are kept for reuse
+  void clear() {
+    if constexpr (std::is_trivially_destructible_v<T>) {
+      size_ = 0;
+    }
+    while (size_ != 0) {
+      pop_back();
+    }
+  }
+
+  void resize(std::size_t size) {
+    while (size_ > size) {
+      pop_back();
+    }
+    reserve(size);
+    while (size_ < size) {
+      emplace_back();
+    }
+  }
+
+  void resize(std::size_t size, const T &value) {
+    while (size_ > size) {
+      pop_back();
+    }
+    reserve(size);
+    while (size_ < size) {
+      emplace_back(value);
+    }
+  }
+
+  void swap(StableVector &other) noexcept {
+    if constexpr (alloc_traits::propagate_on_container_swap::value) {
+      using std::swap;
+      swap(alloc_, other.alloc_);
+    }
+    for (std::size_t b = 0; b < max_blocks_; ++b) {
+      std::swap(blocks_[b], other.blocks_[b]);
+    }
+    std::swap(block_count_, other.block_count_);
+    std::swap(size_, other.size_);
+  }
+
+  // Element access
+  T &at(std::size_t index) {
+    if (index >= size_) {
+      throw std::out_of_range("Index out of range");
+    }
+    return (*this)[index];
+  }
+
+  const T &at(std::size_t index) const {
+    if (index >= size_) {
+      throw std::out_of_range("Index out of range");
+    }
+    return (*this)[index];
+  }
+
+  T &front() { return blocks_[0][0]; }
+  const T &front() const { return blocks_[0][0]; }
+
+  T &back() { return (*this)[size_ - 1]; }
+  const T &back() const { return (*this)[size_ - 1]; }
+
+  // Iterators
+  iterator begin() { return iterator(this, 0); }
+  const_iterator begin() const { return const_iterator(this, 0); }
+  const_iterator cbegin() const { return const_iterator(this, 0); }
+  iterator end() { return iterator(this, size_); }
+  const_iterator end() const { return const_iterator(this, size_); }
+  const_iterator cend() const { return const_iterator(this, size_); }
+
+  // call f(block, count) on every stretch of contiguous elements in order,
+  // a cheaper walk than indexing when the loop body is small
+  template <typename F> void for_each_block(F f) {
+    for (std::size_t b = 0; _block_start(b) < size_; ++b) {
+      f(blocks_[b], std::min(_block_size(b), size_ - _block_start(b)));
+    }
+  }
+
+  template <typename F> void for_each_block(F f) const {
+    for (std::size_t b = 0; _block_start(b) < size_; ++b) {
+      const T *block = blocks_[b];
+      f(block, std::min(_block_size(b), size_ - _block_start(b)));
+    }
+  }
+
+  Alloc get_allocator() const { return alloc_; }
+
+private:
+  static constexpr std::size_t _block_size(std::size_t b) {
+    return FirstBlock << b;
+  }
+
+  // index of the first element in block b, also the capacity of b blocks
+  static constexpr std::size_t _block_start(std::size_t b) {
+    return (FirstBlock << b) - FirstBlock;
+  }
+
+  void _add_block() {
+    if (block_count_ == max_blocks_) {
+      throw std::length_error("StableVector is full");
+    }
+    blocks_[block_count_] =
+        alloc_traits::allocate(alloc_, _block_size(block_count_));
+    ++block_count_;
+  }
+
+  // free blocks from index first on, they must be empty
+  void _release_blocks(std::size_t first) {
+    while (block_count_ > first) {
+      --block_count_;
+      alloc_traits::deallocate(alloc_, blocks_[block_count_],
+                               _block_size(block_count_));
+      blocks_[block_count_] = nullptr;
+    }
+  }
+
+  void _copy_from(const StableVector &other) {
+    reserve(other.size_);
+    other.for_each_block([this](const T *block, std::size_t count) {
+      for (std::size_t i = 0; i < count; ++i) {
+        emplace_back(block[i]);
+      }
+    });
+  }
+
+  T *blocks_[max_blocks_];
+  std::size_t block_count_;
+  std::size_t size_;
+  [[no_unique_address]] Alloc alloc_;
+};
+} // namespace Tiny
+
+#endif // TINY_STABLE_VECTOR_HPP
@@ -5,13 +5,15 @@
 #include <utility>
 
 namespace Tiny {
-template <typename T> class Stack {
+// Container needs empty, size, back, push_back and pop_back,
+// e.g. Vector<T> or SmallVector<T, N>
+template <typename T, typename Container = Vector<T>> class Stack {
 public:
   Stack() = default;
-  Stack(const Stack<T> &) = default;
-  Stack(Stack<T> &&) = default;
-  Stack<T> &operator=(const Stack<T> &) = default;
-  Stack<T> &operator=(Stack<T> &&) = default;
+  Stack(const Stack &) = default;
+  Stack(Stack &&) = default;
+  Stack &operator=(const Stack &) = default;
+  Stack &operator=(Stack &&) = default;
   ~Stack() = default;
 
   bool empty() const { return data.empty(); }
@@ -27,8 +29,8 @@ public:
   void pop() { data.pop_back(); }
 
 private:
-  Vector<T> data;
+  Container data;
 };
 } // namespace Tiny
 
-#endif // TINY_STACK_HPP
\ No newline at end of file
+#endif // TINY_STACK_HPP
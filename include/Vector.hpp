@@ -1,11 +1,153 @@
 #ifndef TINY_VECTOR_HPP
 #define TINY_VECTOR_HPP
 
+#include "Allocator.hpp"
+#include <atomic>
+#include <concepts>
 #include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
 
 namespace Tiny {
-template <typename value_type> class Vector {
+// types that can be moved to a new address with a plain memcpy, leaving the
+// old bytes to be discarded without running a destructor
+// specialize it for types such as pointer-owning handles that are not
+// trivially copyable but are still safe to relocate bitwise
+template <typename T>
+struct is_trivially_relocatable : std::is_trivially_copyable<T> {};
+
+template <typename T>
+inline constexpr bool is_trivially_relocatable_v =
+    is_trivially_relocatable<T>::value;
+
+// growth policies, grow(capacity) is the capacity a full Vector moves to
+// the result is raised to the needed size and rounded by the allocator
+template <typename Policy>
+concept GrowthPolicy = requires(std::size_t capacity) {
+  { Policy::grow(capacity) } -> std::same_as<std::size_t>;
+};
+
+// doubles the capacity, fewest reallocations
+struct GrowDouble {
+  static std::size_t grow(std::size_t capacity) { return capacity * 2 + 1; }
+};
+
+// grows by half, freed blocks can be reused by later growth
+struct GrowHalf {
+  static std::size_t grow(std::size_t capacity) {
+    return capacity + capacity / 2 + 1;
+  }
+};
+
+// grows by a fixed number of elements, least slack for known sizes
+template <std::size_t Chunk> struct GrowChunk {
+  static_assert(Chunk > 0, "GrowChunk needs a positive chunk size.");
+  static std::size_t grow(std::size_t capacity) { return capacity + Chunk; }
+};
+
+// what a Vector did to its storage, for tuning reserve calls
+// only counted when TINY_VECTOR_STATS is defined for the whole program
+struct VectorStats {
+  std::size_t reallocations = 0; // buffers replaced or resized
+  std::size_t moved = 0;         // elements moved or memcpy'd on growth
+  std::size_t copied = 0;        // elements copied since moving could throw
+  std::size_t bytes = 0;         // bytes of elements moved or copied
+  std::size_t peak_capacity = 0; // largest capacity, in elements
+};
+
+namespace Impl {
+#ifdef TINY_VECTOR_STATS
+// process-wide totals of all Vectors, peak_capacity is the largest single one
+struct GlobalVectorStats {
+  std::atomic<std::size_t> reallocations{0};
+  std::atomic<std::size_t> moved{0};
+  std::atomic<std::size_t> copied{0};
+  std::atomic<std::size_t> bytes{0};
+  std::atomic<std::size_t> peak_capacity{0};
+};
+
+inline GlobalVectorStats global_vector_stats;
+
+class VectorStatsRecorder {
+public:
+  void allocated(std::size_t old_capacity, std::size_t capacity) {
+    GlobalVectorStats &global = global_vector_stats;
+    if (old_capacity != 0) {
+      ++stats_.reallocations;
+      global.reallocations.fetch_add(1, std::memory_order_relaxed);
+    }
+    if (capacity > stats_.peak_capacity) {
+      stats_.peak_capacity = capacity;
+      std::size_t peak = global.peak_capacity.load(std::memory_order_relaxed);
+      while (capacity > peak &&
+             !global.peak_capacity.compare_exchange_weak(peak, capacity)) {
+      }
+    }
+  }
+
+  void relocated(std::size_t count, std::size_t bytes, bool copies) {
+    GlobalVectorStats &global = global_vector_stats;
+    (copies ? stats_.copied : stats_.moved) += count;
+    (copies ? global.copied : global.moved)
+        .fetch_add(count, std::memory_order_relaxed);
+    stats_.bytes += bytes;
+    global.bytes.fetch_add(bytes, std::memory_order_relaxed);
+  }
+
+  const VectorStats &get() const { return stats_; }
+
+private:
+  VectorStats stats_;
+};
+#else
+// empty stand-in, every call compiles away
+struct VectorStatsRecorder {
+  void allocated(std::size_t, std::size_t) {}
+  void relocated(std::size_t, std::size_t, bool) {}
+  VectorStats get() const { return VectorStats(); }
+};
+#endif
+} // namespace Impl
+
+// totals over all Vectors in the process, all zero without TINY_VECTOR_STATS
+inline VectorStats vector_stats() {
+  VectorStats stats;
+#ifdef TINY_VECTOR_STATS
+  const Impl::GlobalVectorStats &global = Impl::global_vector_stats;
+  stats.reallocations = global.reallocations.load(std::memory_order_relaxed);
+  stats.moved = global.moved.load(std::memory_order_relaxed);
+  stats.copied = global.copied.load(std::memory_order_relaxed);
+  stats.bytes = global.bytes.load(std::memory_order_relaxed);
+  stats.peak_capacity = global.peak_capacity.load(std::memory_order_relaxed);
+#endif
+  return stats;
+}
+
+inline void reset_vector_stats() {
+#ifdef TINY_VECTOR_STATS
+  Impl::GlobalVectorStats &global = Impl::global_vector_stats;
+  global.reallocations.store(0, std::memory_order_relaxed);
+  global.moved.store(0, std::memory_order_relaxed);
+  global.copied.store(0, std::memory_order_relaxed);
+  global.bytes.store(0, std::memory_order_relaxed);
+  global.peak_capacity.store(0, std::memory_order_relaxed);
+#endif
+}
+
+template <typename T, std::size_t N, typename Alloc> class SmallVector;
+
+template <typename value_type, typename allocator_type = Allocator<value_type>,
+          typename growth_policy = GrowDouble>
+class Vector {
+  static_assert(GrowthPolicy<growth_policy>,
+                "growth_policy needs a static grow(std::size_t).");
+
 private:
+  using alloc_traits = std::allocator_traits<allocator_type>;
   using val_reference = value_type &;
   using val_const_reference = const value_type &;
   using val_pointer = value_type *;
@@ -18,39 +160,114 @@ private:
   val_pointer data_;
   std::size_t size_;
   std::size_t capacity_;
+  [[no_unique_address]] allocator_type alloc_;
+  [[no_unique_address]] Impl::VectorStatsRecorder stats_;
+
+  // storage helpers, all memory goes through alloc_
+  val_pointer _allocate(std::size_t capacity);
+  void _deallocate();
+  void _destroy(std::size_t first, std::size_t last);
+  template <typename... Args> void _construct_tail(std::size_t size,
+                                                   const Args &...args);
+  void _copy_tail(val_const_pointer first, val_const_pointer last);
+  void _relocate(val_pointer src, std::size_t count, val_pointer dst);
+  void _relocate_done(val_pointer src, std::size_t count);
+  void _move_tail(std::size_t from, std::size_t to, std::size_t count);
+  std::size_t _grow_capacity(std::size_t size) const;
+  std::size_t _round_capacity(std::size_t capacity) const;
+  template <typename Fill>
+  val_pointer _insert_fill(std::size_t index, std::size_t count, Fill fill);
+
+  // bitwise relocation is only safe when the allocator does not hook
+  // construction, otherwise its construct would be silently bypassed
+  static constexpr bool relocate_bitwise_ =
+      is_trivially_relocatable_v<value_type> &&
+      !requires(allocator_type &alloc, val_pointer ptr) {
+        alloc.construct(ptr, std::move(*ptr));
+      };
+  // growth goes through allocator reallocate when the bytes may just move
+  static constexpr bool realloc_in_place_ =
+      relocate_bitwise_ && ReallocatingAllocator<allocator_type>;
+  static constexpr bool copy_bitwise_ =
+      std::is_trivially_copyable_v<value_type> &&
+      !requires(allocator_type &alloc, val_pointer ptr) {
+        alloc.construct(ptr, *ptr);
+      };
+  // move_if_noexcept falls back to copying during relocation
+  static constexpr bool relocate_copies_ =
+      !relocate_bitwise_ &&
+      !std::is_nothrow_move_constructible_v<value_type> &&
+      std::is_copy_constructible_v<value_type>;
+
+public:
+  using iterator = value_type *;
+  using const_iterator = const value_type *;
+
+  // guaranteed alignment of data(), kernels may pass it to assume_aligned
+  static constexpr std::size_t alignment = [] {
+    if constexpr (requires { allocator_type::alignment; }) {
+      return allocator_type::alignment;
+    } else {
+      return alignof(value_type);
+    }
+  }();
 
 public:
   // Constructors
-  Vector();
-  Vector(std::size_t size);
-  Vector(std::size_t size, val_const_reference value);
-  Vector(val_const_pointer first, val_const_pointer last);
+  Vector() noexcept(noexcept(allocator_type()));
+  explicit Vector(const allocator_type &alloc) noexcept;
+  Vector(std::size_t size, const allocator_type &alloc = allocator_type());
+  Vector(std::size_t size, val_const_reference value,
+         const allocator_type &alloc = allocator_type());
+  Vector(val_const_pointer first, val_const_pointer last,
+         const allocator_type &alloc = allocator_type());
   Vector(const Vector &other);
+  Vector(const Vector &other, const allocator_type &alloc);
   Vector(Vector &&other) noexcept;
+  Vector(Vector &&other, const allocator_type &alloc);
 
   // Destructor
   ~Vector();
 
   // Operators
   vec_reference operator=(const Vector &other);
-  vec_reference operator=(Vector &&other);
+  vec_reference operator=(Vector &&other) noexcept(
+      alloc_traits::propagate_on_container_move_assignment::value ||
+      alloc_traits::is_always_equal::value);
   val_reference operator[](std::size_t index);
   val_const_reference operator[](std::size_t index) const;
 
   // Capacity
   std::size_t size() const;
   std::size_t capacity() const;
+  bool empty() const;
 
   // Modifiers
   void assign(std::size_t size, val_const_reference value);
   void assign(val_const_pointer first, val_const_pointer last);
-  template <typename... Args> void emplace_back(Args... args);
+  template <typename... Args> void emplace_back(Args &&...args);
+  template <typename... Args>
+  iterator emplace(const_iterator pos, Args &&...args);
   void push_back(val_const_reference value);
+  void push_back(value_type &&value);
   void pop_back();
+  iterator insert(const_iterator pos, val_const_reference value);
+  iterator insert(const_iterator pos, value_type &&value);
+  iterator insert(const_iterator pos, std::size_t count,
+                  val_const_reference value);
+  template <std::forward_iterator ForwardIt>
+  iterator insert(const_iterator pos, ForwardIt first, ForwardIt last);
+  iterator erase(const_iterator pos);
+  iterator erase(const_iterator first, const_iterator last);
   void clear();
   void resize(std::size_t size);
   void resize(std::size_t size, val_const_reference value);
   void reserve(std::size_t capacity);
+  void shrink_to_fit();
+  void swap(Vector &other) noexcept;
+
+  // Stats, all zero unless TINY_VECTOR_STATS is defined
+  VectorStats stats() const;
 
   // Element access
   val_reference at(std::size_t index);
@@ -59,270 +276,786 @@ public:
   val_const_reference front() const;
   val_reference back();
   val_const_reference back() const;
+  val_pointer data();
   val_const_pointer data() const;
+
+  // Iterators
+  iterator begin();
+  const_iterator begin() const;
+  const_iterator cbegin() const;
+  iterator end();
+  const_iterator end() const;
+  const_iterator cend() const;
+
+  // Allocator
+  allocator_type get_allocator() const;
+
+  // SmallVector hands heap buffers to and from Vector without copying
+  template <typename T, std::size_t N, typename Alloc>
+  friend class SmallVector;
 };
+
+// Vector whose data() is aligned to Align bytes and whose capacity is padded
+// to whole Align chunks, for SIMD kernels that want aligned full-width loads
+template <typename T, std::size_t Align = 64>
+using AlignedVector = Vector<T, AlignedAllocator<T, Align>>;
 } // namespace Tiny
 
-// ==== Constructors Begin Here ====
-// default constructor
-template <typename value_type>
-Tiny::Vector<value_type>::Vector() : data_(nullptr), size_(0), capacity_(0) {}
+// ==== Storage Helpers Begin Here ====
+// allocate raw storage for capacity elements
+template <typename value_type, typename allocator_type, typename growth_policy>
+typename Tiny::Vector<value_type, allocator_type, growth_policy>::val_pointer
+Tiny::Vector<value_type, allocator_type, growth_policy>::_allocate(
+    std::size_t capacity) {
+  if (capacity == 0) {
+    return nullptr;
+  }
+  return alloc_traits::allocate(alloc_, capacity);
+}
 
-// constructor with size
-template <typename value_type>
-Tiny::Vector<value_type>::Vector(std::size_t size)
-    : size_(size), capacity_(size) {
-  if (size == 0) {
-    data_ = nullptr;
-    return;
+// give the current buffer back to the allocator
+template <typename value_type, typename allocator_type, typename growth_policy>
+void Tiny::Vector<value_type, allocator_type, growth_policy>::_deallocate() {
+  if (data_ != nullptr) {
+    alloc_traits::deallocate(alloc_, data_, capacity_);
   }
+  data_ = nullptr;
+  capacity_ = 0;
+}
 
-  try {
-    data_ = new value_type[size];
-  } catch (std::bad_alloc &e) {
-    throw e;
+// destroy elements in [first, last)
+template <typename value_type, typename allocator_type, typename growth_policy>
+void Tiny::Vector<value_type, allocator_type, growth_policy>::_destroy(
+    std::size_t first, std::size_t last) {
+  for (std::size_t i = first; i < last; ++i) {
+    alloc_traits::destroy(alloc_, data_ + i);
   }
+}
 
-  for (std::size_t i = 0; i < size; ++i) {
-    new (&data_[i]) value_type();
+// construct elements from size_ up to size with args
+// size_ follows every constructed element, so a throw leaves a valid vector
+template <typename value_type, typename allocator_type, typename growth_policy>
+template <typename... Args>
+void Tiny::Vector<value_type, allocator_type, growth_policy>::_construct_tail(
+    std::size_t size, const Args &...args) {
+  for (; size_ < size; ++size_) {
+    alloc_traits::construct(alloc_, data_ + size_, args...);
   }
 }
 
-// constructor with size and value
-// initialize all elements with value given
-template <typename value_type>
-Tiny::Vector<value_type>::Vector(std::size_t size, val_const_reference value)
-    : size_(size), capacity_(size) {
-  try {
-    data_ = new value_type[size];
-  } catch (std::bad_alloc &e) {
-    throw e;
+// copy construct [first, last) after the last element
+template <typename value_type, typename allocator_type, typename growth_policy>
+void Tiny::Vector<value_type, allocator_type, growth_policy>::_copy_tail(
+    val_const_pointer first, val_const_pointer last) {
+  for (; first != last; ++first, ++size_) {
+    alloc_traits::construct(alloc_, data_ + size_, *first);
   }
+}
 
-  for (std::size_t i = 0; i < size; ++i) {
-    new (&data_[i]) value_type(value);
+// construct count elements at raw dst from src, the source stays alive
+// until _relocate_done, so a throw leaves it untouched
+// trivially relocatable types go with a single memcpy, everything else uses
+// move_if_noexcept and destroys the partial copy on failure
+template <typename value_type, typename allocator_type, typename growth_policy>
+void Tiny::Vector<value_type, allocator_type, growth_policy>::_relocate(
+    val_pointer src, std::size_t count, val_pointer dst) {
+  if constexpr (relocate_bitwise_) {
+    if (count != 0) {
+      std::memcpy(static_cast<void *>(dst), static_cast<const void *>(src),
+                  count * sizeof(value_type));
+    }
+  } else {
+    std::size_t i = 0;
+    try {
+      for (; i < count; ++i) {
+        alloc_traits::construct(alloc_, dst + i,
+                                std::move_if_noexcept(src[i]));
+      }
+    } catch (...) {
+      for (std::size_t j = 0; j < i; ++j) {
+        alloc_traits::destroy(alloc_, dst + j);
+      }
+      throw;
+    }
   }
+  stats_.relocated(count, count * sizeof(value_type), relocate_copies_);
 }
 
-// constructor with first and last pointer
-// initialize all elements with value from first to last
-template <typename value_type>
-Tiny::Vector<value_type>::Vector(val_const_pointer first,
-                                 val_const_pointer last)
-    : size_(last - first), capacity_(last - first) {
-  try {
-    data_ = new value_type[capacity_];
-  } catch (std::bad_alloc &e) {
-    throw e;
+// end the source side of a finished _relocate
+// bitwise relocated bytes are simply forgotten
+template <typename value_type, typename allocator_type, typename growth_policy>
+void Tiny::Vector<value_type, allocator_type, growth_policy>::_relocate_done(
+    val_pointer src, std::size_t count) {
+  if constexpr (!relocate_bitwise_) {
+    for (std::size_t i = 0; i < count; ++i) {
+      alloc_traits::destroy(alloc_, src + i);
+    }
   }
+}
 
-  for (std::size_t i = 0; i < size_; ++i) {
-    new (&data_[i]) value_type(first[i]);
+// relocate count elements from data_ + from to raw storage at data_ + to
+// the ranges may overlap, bitwise types move with a single memmove
+// a throwing move destroys the whole tail, so callers shrink size_ to the
+// part that stays valid before calling
+template <typename value_type, typename allocator_type, typename growth_policy>
+void Tiny::Vector<value_type, allocator_type, growth_policy>::_move_tail(
+    std::size_t from, std::size_t to, std::size_t count) {
+  if (count == 0 || from == to) {
+    return;
+  }
+
+  if constexpr (relocate_bitwise_) {
+    std::memmove(static_cast<void *>(data_ + to),
+                 static_cast<const void *>(data_ + from),
+                 count * sizeof(value_type));
+  } else {
+    // walk away from the overlap: back to front when moving up
+    const bool up = to > from;
+    std::size_t done = 0;
+    try {
+      for (; done < count; ++done) {
+        std::size_t i = up ? count - 1 - done : done;
+        alloc_traits::construct(alloc_, data_ + to + i,
+                                std::move(data_[from + i]));
+        alloc_traits::destroy(alloc_, data_ + from + i);
+      }
+    } catch (...) {
+      for (std::size_t i = 0; i < count; ++i) {
+        bool moved = up ? i > count - 1 - done : i < done;
+        alloc_traits::destroy(alloc_, data_ + (moved ? to : from) + i);
+      }
+      throw;
+    }
   }
 }
 
-// copy constructor
-template <typename value_type>
-Tiny::Vector<value_type>::Vector(const Vector &other)
-    : size_(other.size_), capacity_(other.capacity_) {
-  try {
-    data_ = new value_type[capacity_];
-  } catch (std::bad_alloc &e) {
-    throw e;
+// capacity to grow to when size elements no longer fit
+template <typename value_type, typename allocator_type, typename growth_policy>
+std::size_t
+Tiny::Vector<value_type, allocator_type, growth_policy>::_grow_capacity(
+    std::size_t size) const {
+  std::size_t capacity = growth_policy::grow(capacity_);
+  return _round_capacity(capacity < size ? size : capacity);
+}
+
+// let the allocator pad a capacity, e.g. to whole SIMD registers
+template <typename value_type, typename allocator_type, typename growth_policy>
+std::size_t
+Tiny::Vector<value_type, allocator_type, growth_policy>::_round_capacity(
+    std::size_t capacity) const {
+  if constexpr (CapacityRoundingAllocator<allocator_type>) {
+    return alloc_.round_capacity(capacity);
+  } else {
+    return capacity;
   }
+}
+
+// open a gap of count raw slots at index and let fill(dst) construct them
+// fill must destroy whatever it built before rethrowing
+// when the buffer is full the gap is built in the new buffer first, so fill
+// may still read from the old elements, and growth happens at most once
+template <typename value_type, typename allocator_type, typename growth_policy>
+template <typename Fill>
+typename Tiny::Vector<value_type, allocator_type, growth_policy>::val_pointer
+Tiny::Vector<value_type, allocator_type, growth_policy>::_insert_fill(
+    std::size_t index, std::size_t count, Fill fill) {
+  const std::size_t tail = size_ - index;
 
-  for (std::size_t i = 0; i < size_; ++i) {
-    new (&data_[i]) value_type(other.data_[i]);
+  if constexpr (realloc_in_place_) {
+    // the buffer is resized where it lies, then filled like any other gap
+    if (size_ + count > capacity_) {
+      reserve(_grow_capacity(size_ + count));
+    }
   }
+
+  if (size_ + count > capacity_) {
+    const std::size_t capacity = _grow_capacity(size_ + count);
+    val_pointer new_data = _allocate(capacity);
+    try {
+      fill(new_data + index);
+      try {
+        _relocate(data_, index, new_data);
+        try {
+          _relocate(data_ + index, tail, new_data + index + count);
+        } catch (...) {
+          if constexpr (!relocate_bitwise_) {
+            for (std::size_t i = 0; i < index; ++i) {
+              alloc_traits::destroy(alloc_, new_data + i);
+            }
+          }
+          throw;
+        }
+      } catch (...) {
+        for (std::size_t i = 0; i < count; ++i) {
+          alloc_traits::destroy(alloc_, new_data + index + i);
+        }
+        throw;
+      }
+    } catch (...) {
+      alloc_traits::deallocate(alloc_, new_data, capacity);
+      throw;
+    }
+    stats_.allocated(capacity_, capacity);
+    _relocate_done(data_, size_);
+    _deallocate();
+    data_ = new_data;
+    capacity_ = capacity;
+    size_ += count;
+    return data_ + index;
+  }
+
+  size_ = index;
+  _move_tail(index, index + count, tail);
+  try {
+    fill(data_ + index);
+  } catch (...) {
+    _move_tail(index + count, index, tail);
+    size_ = index + tail;
+    throw;
+  }
+  size_ = index + count + tail;
+  return data_ + index;
+}
+// ==== Storage Helpers End Here ====
+
+// ==== Constructors Begin Here ====
+// default constructor
+template <typename value_type, typename allocator_type, typename growth_policy>
+Tiny::Vector<value_type, allocator_type, growth_policy>::Vector() noexcept(
+    noexcept(allocator_type()))
+    : data_(nullptr), size_(0), capacity_(0), alloc_() {}
+
+// constructor with allocator
+template <typename value_type, typename allocator_type, typename growth_policy>
+Tiny::Vector<value_type, allocator_type, growth_policy>::Vector(
+    const allocator_type &alloc) noexcept
+    : data_(nullptr), size_(0), capacity_(0), alloc_(alloc) {}
+
+// constructor with size
+// the delegated constructor has finished, so a throw here runs ~Vector
+template <typename value_type, typename allocator_type, typename growth_policy>
+Tiny::Vector<value_type, allocator_type, growth_policy>::Vector(
+    std::size_t size, const allocator_type &alloc)
+    : Vector(alloc) {
+  reserve(size);
+  _construct_tail(size);
+}
+
+// constructor with size and value
+// initialize all elements with value given
+template <typename value_type, typename allocator_type, typename growth_policy>
+Tiny::Vector<value_type, allocator_type, growth_policy>::Vector(
+    std::size_t size, val_const_reference value, const allocator_type &alloc)
+    : Vector(alloc) {
+  reserve(size);
+  _construct_tail(size, value);
+}
+
+// constructor with first and last pointer
+// initialize all elements with value from first to last
+template <typename value_type, typename allocator_type, typename growth_policy>
+Tiny::Vector<value_type, allocator_type, growth_policy>::Vector(
+    val_const_pointer first, val_const_pointer last,
+    const allocator_type &alloc)
+    : Vector(alloc) {
+  reserve(last - first);
+  _copy_tail(first, last);
+}
+
+// copy constructor
+// the allocator decides what a copy of itself looks like
+template <typename value_type, typename allocator_type, typename growth_policy>
+Tiny::Vector<value_type, allocator_type, growth_policy>::Vector(
+    const Vector &other)
+    : Vector(other, alloc_traits::select_on_container_copy_construction(
+                        other.alloc_)) {}
+
+// copy constructor with allocator
+template <typename value_type, typename allocator_type, typename growth_policy>
+Tiny::Vector<value_type, allocator_type, growth_policy>::Vector(
+    const Vector &other, const allocator_type &alloc)
+    : Vector(alloc) {
+  reserve(other.capacity_);
+  _copy_tail(other.data_, other.data_ + other.size_);
 }
 
 // move constructor
-template <typename value_type>
-Tiny::Vector<value_type>::Vector(Vector &&other) noexcept
-    : data_(other.data_), size_(other.size_), capacity_(other.capacity_) {
+// the allocator always moves along with the buffer
+template <typename value_type, typename allocator_type, typename growth_policy>
+Tiny::Vector<value_type, allocator_type, growth_policy>::Vector(
+    Vector &&other) noexcept
+    : data_(other.data_), size_(other.size_), capacity_(other.capacity_),
+      alloc_(std::move(other.alloc_)) {
   other.data_ = nullptr;
   other.size_ = 0;
   other.capacity_ = 0;
 }
+
+// move constructor with allocator
+// the buffer can only be stolen if alloc can free it
+template <typename value_type, typename allocator_type, typename growth_policy>
+Tiny::Vector<value_type, allocator_type, growth_policy>::Vector(
+    Vector &&other, const allocator_type &alloc)
+    : Vector(alloc) {
+  if (alloc_ == other.alloc_) {
+    data_ = std::exchange(other.data_, nullptr);
+    size_ = std::exchange(other.size_, 0);
+    capacity_ = std::exchange(other.capacity_, 0);
+    return;
+  }
+
+  reserve(other.size_);
+  for (; size_ < other.size_; ++size_) {
+    alloc_traits::construct(alloc_, data_ + size_,
+                            std::move(other.data_[size_]));
+  }
+}
 // ==== Constructors End Here ====
 
 // ==== Destructor Begin Here ====
-template <typename value_type> Tiny::Vector<value_type>::~Vector() {
-  for (std::size_t i = 0; i < size_; ++i) {
-    data_[i].~value_type();
-  }
-  delete[] data_;
+template <typename value_type, typename allocator_type, typename growth_policy>
+Tiny::Vector<value_type, allocator_type, growth_policy>::~Vector() {
+  _destroy(0, size_);
+  _deallocate();
 }
 // ==== Destructor End Here ====
 
 // ==== Operators Begin Here ====
 // copy assignment operator
-template <typename value_type>
-typename Tiny::Vector<value_type>::vec_reference
-Tiny::Vector<value_type>::operator=(const Vector &other) {
-  return *this = Vector(other);
+// with propagate_on_container_copy_assignment the allocator is copied too,
+// memory from the old allocator is released before switching over
+template <typename value_type, typename allocator_type, typename growth_policy>
+typename Tiny::Vector<value_type, allocator_type, growth_policy>::vec_reference
+Tiny::Vector<value_type, allocator_type, growth_policy>::operator=(
+    const Vector &other) {
+  if (this == &other) {
+    return *this;
+  }
+
+  _destroy(0, size_);
+  size_ = 0;
+
+  if constexpr (alloc_traits::propagate_on_container_copy_assignment::value) {
+    if (alloc_ != other.alloc_) {
+      _deallocate();
+    }
+    alloc_ = other.alloc_;
+  }
+
+  if (other.size_ > capacity_) {
+    const std::size_t capacity = _round_capacity(other.size_);
+    stats_.allocated(capacity_, capacity);
+    _deallocate();
+    data_ = _allocate(capacity);
+    capacity_ = capacity;
+  }
+  _copy_tail(other.data_, other.data_ + other.size_);
+  return *this;
 }
 
 // move assignment operator
-template <typename value_type>
-typename Tiny::Vector<value_type>::vec_reference
-Tiny::Vector<value_type>::operator=(Vector &&other) {
-  return *this = std::move(other);
+// the buffer is stolen when the allocator propagates or compares equal,
+// otherwise elements are moved one by one into our own storage
+template <typename value_type, typename allocator_type, typename growth_policy>
+typename Tiny::Vector<value_type, allocator_type, growth_policy>::vec_reference
+Tiny::Vector<value_type, allocator_type, growth_policy>::operator=(
+    Vector &&other) noexcept(
+    alloc_traits::propagate_on_container_move_assignment::value ||
+    alloc_traits::is_always_equal::value) {
+  if (this == &other) {
+    return *this;
+  }
+
+  constexpr bool propagate =
+      alloc_traits::propagate_on_container_move_assignment::value;
+  if (propagate || alloc_ == other.alloc_) {
+    clear();
+    if constexpr (propagate) {
+      alloc_ = std::move(other.alloc_);
+    }
+    data_ = std::exchange(other.data_, nullptr);
+    size_ = std::exchange(other.size_, 0);
+    capacity_ = std::exchange(other.capacity_, 0);
+    return *this;
+  }
+
+  _destroy(0, size_);
+  size_ = 0;
+  reserve(other.size_);
+  for (; size_ < other.size_; ++size_) {
+    alloc_traits::construct(alloc_, data_ + size_,
+                            std::move(other.data_[size_]));
+  }
+  other.clear();
+  return *this;
 }
 
 // get element at index
-template <typename value_type>
-typename Tiny::Vector<value_type>::val_reference
-Tiny::Vector<value_type>::operator[](std::size_t index) {
+template <typename value_type, typename allocator_type, typename growth_policy>
+typename Tiny::Vector<value_type, allocator_type, growth_policy>::val_reference
+Tiny::Vector<value_type, allocator_type, growth_policy>::operator[](
+    std::size_t index) {
   return data_[index];
 }
 
 // get element at index
-template <typename value_type>
-typename Tiny::Vector<value_type>::val_const_reference
-Tiny::Vector<value_type>::operator[](std::size_t index) const {
+template <typename value_type, typename allocator_type, typename growth_policy>
+typename Tiny::Vector<value_type, allocator_type,
+                      growth_policy>::val_const_reference
+Tiny::Vector<value_type, allocator_type, growth_policy>::operator[](
+    std::size_t index) const {
   return data_[index];
 }
 // ==== Operators End Here ====
 
 // ==== Capacity Begin Here ====
 // get size
-template <typename value_type>
-std::size_t Tiny::Vector<value_type>::size() const {
+template <typename value_type, typename allocator_type, typename growth_policy>
+std::size_t
+Tiny::Vector<value_type, allocator_type, growth_policy>::size() const {
   return size_;
 }
 
 // get capacity
-template <typename value_type>
-std::size_t Tiny::Vector<value_type>::capacity() const {
+template <typename value_type, typename allocator_type, typename growth_policy>
+std::size_t
+Tiny::Vector<value_type, allocator_type, growth_policy>::capacity() const {
   return capacity_;
 }
+
+// check if there are no elements
+template <typename value_type, typename allocator_type, typename growth_policy>
+bool Tiny::Vector<value_type, allocator_type, growth_policy>::empty() const {
+  return size_ == 0;
+}
 // ==== Capacity End Here ====
 
 // ==== Modifiers Begin Here ====
 // assign size and value
-template <typename value_type>
-void Tiny::Vector<value_type>::assign(std::size_t size,
-                                      val_const_reference value) {
-  *this = Vector(size, value);
+template <typename value_type, typename allocator_type, typename growth_policy>
+void Tiny::Vector<value_type, allocator_type, growth_policy>::assign(
+    std::size_t size, val_const_reference value) {
+  *this = Vector(size, value, alloc_);
 }
 
 // assign first and last pointer
-template <typename value_type>
-void Tiny::Vector<value_type>::assign(val_const_pointer first,
-                                      val_const_pointer last) {
-  *this = Vector(first, last);
+template <typename value_type, typename allocator_type, typename growth_policy>
+void Tiny::Vector<value_type, allocator_type, growth_policy>::assign(
+    val_const_pointer first, val_const_pointer last) {
+  *this = Vector(first, last, alloc_);
 }
 
 // emplace_back
-template <typename value_type>
+// args are perfectly forwarded; when growing, the new element is built in
+// the new buffer before the old one goes away, so args may alias elements
+template <typename value_type, typename allocator_type, typename growth_policy>
 template <typename... Args>
-void Tiny::Vector<value_type>::emplace_back(Args... args) {
+void Tiny::Vector<value_type, allocator_type, growth_policy>::emplace_back(
+    Args &&...args) {
+  if constexpr (realloc_in_place_) {
+    // reallocate may move the old buffer, build the value before growing
+    if (size_ == capacity_) {
+      value_type value(std::forward<Args>(args)...);
+      reserve(_grow_capacity(size_ + 1));
+      alloc_traits::construct(alloc_, data_ + size_, std::move(value));
+      ++size_;
+      return;
+    }
+  }
   if (size_ == capacity_) {
-    reserve(capacity_ * 2 + 1);
+    _insert_fill(size_, 1, [&](val_pointer dst) {
+      alloc_traits::construct(alloc_, dst, std::forward<Args>(args)...);
+    });
+    return;
   }
-  new (&data_[size_++]) value_type(std::forward<Args>(args)...);
+  alloc_traits::construct(alloc_, data_ + size_, std::forward<Args>(args)...);
+  ++size_;
+}
+
+// emplace before pos
+// the value is built up front because args may refer to elements that are
+// about to be shifted
+template <typename value_type, typename allocator_type, typename growth_policy>
+template <typename... Args>
+typename Tiny::Vector<value_type, allocator_type, growth_policy>::iterator
+Tiny::Vector<value_type, allocator_type, growth_policy>::emplace(
+    const_iterator pos, Args &&...args) {
+  const std::size_t index = pos - data_;
+  if (index == size_) {
+    emplace_back(std::forward<Args>(args)...);
+    return data_ + index;
+  }
+
+  value_type value(std::forward<Args>(args)...);
+  return _insert_fill(index, 1, [&](val_pointer dst) {
+    alloc_traits::construct(alloc_, dst, std::move(value));
+  });
 }
 
 // push_back
-template <typename value_type>
-void Tiny::Vector<value_type>::push_back(val_const_reference value) {
+template <typename value_type, typename allocator_type, typename growth_policy>
+void Tiny::Vector<value_type, allocator_type, growth_policy>::push_back(
+    val_const_reference value) {
   emplace_back(value);
 }
 
+// push_back with rvalue
+template <typename value_type, typename allocator_type, typename growth_policy>
+void Tiny::Vector<value_type, allocator_type, growth_policy>::push_back(
+    value_type &&value) {
+  emplace_back(std::move(value));
+}
+
 // pop_back
-template <typename value_type> void Tiny::Vector<value_type>::pop_back() {
-  data_[--size_].~value_type();
+template <typename value_type, typename allocator_type, typename growth_policy>
+void Tiny::Vector<value_type, allocator_type, growth_policy>::pop_back() {
+  alloc_traits::destroy(alloc_, data_ + --size_);
+}
+
+// insert value before pos
+template <typename value_type, typename allocator_type, typename growth_policy>
+typename Tiny::Vector<value_type, allocator_type, growth_policy>::iterator
+Tiny::Vector<value_type, allocator_type, growth_policy>::insert(
+    const_iterator pos, val_const_reference value) {
+  return emplace(pos, value);
+}
+
+// insert value before pos by moving it
+template <typename value_type, typename allocator_type, typename growth_policy>
+typename Tiny::Vector<value_type, allocator_type, growth_policy>::iterator
+Tiny::Vector<value_type, allocator_type, growth_policy>::insert(
+    const_iterator pos, value_type &&value) {
+  return emplace(pos, std::move(value));
+}
+
+// insert count copies of value before pos
+template <typename value_type, typename allocator_type, typename growth_policy>
+typename Tiny::Vector<value_type, allocator_type, growth_policy>::iterator
+Tiny::Vector<value_type, allocator_type, growth_policy>::insert(
+    const_iterator pos, std::size_t count, val_const_reference value) {
+  const std::size_t index = pos - data_;
+  if (count == 0) {
+    return data_ + index;
+  }
+
+  // value may live inside the vector, keep a copy across the shift
+  const value_type copy(value);
+  return _insert_fill(index, count, [&](val_pointer dst) {
+    std::size_t i = 0;
+    try {
+      for (; i < count; ++i) {
+        alloc_traits::construct(alloc_, dst + i, copy);
+      }
+    } catch (...) {
+      for (std::size_t j = 0; j < i; ++j) {
+        alloc_traits::destroy(alloc_, dst + j);
+      }
+      throw;
+    }
+  });
+}
+
+// insert [first, last) before pos
+// the tail is shifted once and the buffer grows at most once
+// [first, last) must not point into this vector
+template <typename value_type, typename allocator_type, typename growth_policy>
+template <std::forward_iterator ForwardIt>
+typename Tiny::Vector<value_type, allocator_type, growth_policy>::iterator
+Tiny::Vector<value_type, allocator_type, growth_policy>::insert(
+    const_iterator pos, ForwardIt first, ForwardIt last) {
+  const std::size_t index = pos - data_;
+  const std::size_t count = std::distance(first, last);
+  if (count == 0) {
+    return data_ + index;
+  }
+
+  return _insert_fill(index, count, [&](val_pointer dst) {
+    if constexpr (copy_bitwise_ && std::contiguous_iterator<ForwardIt> &&
+                  std::is_same_v<std::iter_value_t<ForwardIt>, value_type>) {
+      std::memcpy(static_cast<void *>(dst),
+                  static_cast<const void *>(std::to_address(first)),
+                  count * sizeof(value_type));
+    } else {
+      std::size_t i = 0;
+      try {
+        for (ForwardIt it = first; i < count; ++it, ++i) {
+          alloc_traits::construct(alloc_, dst + i, *it);
+        }
+      } catch (...) {
+        for (std::size_t j = 0; j < i; ++j) {
+          alloc_traits::destroy(alloc_, dst + j);
+        }
+        throw;
+      }
+    }
+  });
+}
+
+// erase element at pos
+template <typename value_type, typename allocator_type, typename growth_policy>
+typename Tiny::Vector<value_type, allocator_type, growth_policy>::iterator
+Tiny::Vector<value_type, allocator_type, growth_policy>::erase(
+    const_iterator pos) {
+  return erase(pos, pos + 1);
+}
+
+// erase [first, last), the tail is shifted down once
+template <typename value_type, typename allocator_type, typename growth_policy>
+typename Tiny::Vector<value_type, allocator_type, growth_policy>::iterator
+Tiny::Vector<value_type, allocator_type, growth_policy>::erase(
+    const_iterator first, const_iterator last) {
+  const std::size_t index = first - data_;
+  const std::size_t count = last - first;
+  if (count == 0) {
+    return data_ + index;
+  }
+
+  const std::size_t tail = size_ - index - count;
+  _destroy(index, index + count);
+  size_ = index;
+  _move_tail(index + count, index, tail);
+  size_ = index + tail;
+  return data_ + index;
 }
 
 // clear
-template <typename value_type> void Tiny::Vector<value_type>::clear() {
+template <typename value_type, typename allocator_type, typename growth_policy>
+void Tiny::Vector<value_type, allocator_type, growth_policy>::clear() {
   if (data_ == nullptr) {
     return;
   }
 
   // release memory
-  for (std::size_t i = 0; i < size_; ++i) {
-    data_[i].~value_type();
-  }
-
-  delete[] data_;
-  data_ = nullptr;
+  _destroy(0, size_);
+  _deallocate();
   size_ = 0;
-  capacity_ = 0;
 }
 
 // resize
-template <typename value_type>
-void Tiny::Vector<value_type>::resize(std::size_t size) {
+template <typename value_type, typename allocator_type, typename growth_policy>
+void Tiny::Vector<value_type, allocator_type, growth_policy>::resize(
+    std::size_t size) {
   if (size < size_) {
     // if size is less than current size, destruct elements
-    for (std::size_t i = size; i < size_; ++i) {
-      data_[i].~value_type();
-    }
+    _destroy(size, size_);
+    size_ = size;
   } else if (size > size_) {
     // if size is greater than current size, construct elements
     if (size > capacity_) {
       reserve(size);
     }
-    for (std::size_t i = size_; i < size; ++i) {
-      new (&data_[i]) value_type();
-    }
+    _construct_tail(size);
   }
-  size_ = size;
 }
 
 // resize with value
-template <typename value_type>
-void Tiny::Vector<value_type>::resize(std::size_t size,
-                                      val_const_reference value) {
+template <typename value_type, typename allocator_type, typename growth_policy>
+void Tiny::Vector<value_type, allocator_type, growth_policy>::resize(
+    std::size_t size, val_const_reference value) {
   if (size < size_) {
     // if size is less than current size, destruct elements
-    for (std::size_t i = size; i < size_; ++i) {
-      data_[i].~value_type();
-    }
+    _destroy(size, size_);
+    size_ = size;
   } else if (size > size_) {
     // if size is greater than current size, construct elements
     if (size > capacity_) {
       reserve(size);
     }
-    for (std::size_t i = size_; i < size; ++i) {
-      new (&data_[i]) value_type(value);
-    }
+    _construct_tail(size, value);
   }
-  size_ = size;
 }
 
 // reserve capacity
-template <typename value_type>
-void Tiny::Vector<value_type>::reserve(std::size_t capacity) {
+template <typename value_type, typename allocator_type, typename growth_policy>
+void Tiny::Vector<value_type, allocator_type, growth_policy>::reserve(
+    std::size_t capacity) {
   // if capacity is less than or equal to current capacity, return
   if (capacity <= capacity_) {
     return;
   }
-  // create new data with new capacity
-  try {
-    val_pointer new_data = new value_type[capacity];
+  capacity = _round_capacity(capacity);
 
-    for (std::size_t i = 0; i < size_; ++i) {
-      new (&new_data[i]) value_type(std::move(data_[i]));
-      data_[i].~value_type();
+  if constexpr (realloc_in_place_) {
+    // let the allocator grow the block, e.g. by remapping its pages
+    if (data_ != nullptr) {
+      data_ = alloc_.reallocate(data_, capacity_, capacity);
+      stats_.allocated(capacity_, capacity);
+      capacity_ = capacity;
+      return;
     }
-    delete[] data_;
-    data_ = new_data;
+  }
+
+  // create new raw storage with new capacity, nothing is constructed yet
+  val_pointer new_data = _allocate(capacity);
+
+  try {
+    _relocate(data_, size_, new_data);
+  } catch (...) {
+    alloc_traits::deallocate(alloc_, new_data, capacity);
+    throw;
+  }
+  stats_.allocated(capacity_, capacity);
+  _relocate_done(data_, size_);
+  _deallocate();
+  data_ = new_data;
+  capacity_ = capacity;
+}
+
+// shrink capacity down to size
+// a reallocating allocator trims the block in place and returns the pages
+template <typename value_type, typename allocator_type, typename growth_policy>
+void Tiny::Vector<value_type, allocator_type, growth_policy>::shrink_to_fit() {
+  if (size_ == 0) {
+    _deallocate();
+    return;
+  }
+  const std::size_t capacity = _round_capacity(size_);
+  if (capacity_ == capacity) {
+    return;
+  }
+
+  if constexpr (realloc_in_place_) {
+    data_ = alloc_.reallocate(data_, capacity_, capacity);
+    stats_.allocated(capacity_, capacity);
     capacity_ = capacity;
-  } catch (std::bad_alloc &e) {
-    throw e; // throw exception if memory allocation fails
+    return;
+  }
+
+  val_pointer new_data = _allocate(capacity);
+  try {
+    _relocate(data_, size_, new_data);
+  } catch (...) {
+    alloc_traits::deallocate(alloc_, new_data, capacity);
+    throw;
   }
+  stats_.allocated(capacity_, capacity);
+  _relocate_done(data_, size_);
+  _deallocate();
+  data_ = new_data;
+  capacity_ = capacity;
+}
+
+// swap contents with other
+// allocators are only exchanged with propagate_on_container_swap
+template <typename value_type, typename allocator_type, typename growth_policy>
+void Tiny::Vector<value_type, allocator_type, growth_policy>::swap(
+    Vector &other) noexcept {
+  if constexpr (alloc_traits::propagate_on_container_swap::value) {
+    using std::swap;
+    swap(alloc_, other.alloc_);
+  }
+  std::swap(data_, other.data_);
+  std::swap(size_, other.size_);
+  std::swap(capacity_, other.capacity_);
 }
 // ==== Modifiers End Here ====
 
 // ==== Element Access Begin Here ====
 // at with index
 // if index is out of range, throw exception
-template <typename value_type>
-typename Tiny::Vector<value_type>::val_reference
-Tiny::Vector<value_type>::at(std::size_t index) {
+template <typename value_type, typename allocator_type, typename growth_policy>
+typename Tiny::Vector<value_type, allocator_type, growth_policy>::val_reference
+Tiny::Vector<value_type, allocator_type, growth_policy>::at(std::size_t index) {
   if (index >= size_) {
     throw std::out_of_range("Index out of range");
   }
@@ -330,9 +1063,11 @@ Tiny::Vector<value_type>::at(std::size_t index) {
 }
 
 // at with index
-template <typename value_type>
-typename Tiny::Vector<value_type>::val_const_reference
-Tiny::Vector<value_type>::at(std::size_t index) const {
+template <typename value_type, typename allocator_type, typename growth_policy>
+typename Tiny::Vector<value_type, allocator_type,
+                      growth_policy>::val_const_reference
+Tiny::Vector<value_type, allocator_type, growth_policy>::at(
+    std::size_t index) const {
   if (index >= size_) {
     throw std::out_of_range("Index out of range");
   }
@@ -340,39 +1075,106 @@ Tiny::Vector<value_type>::at(std::size_t index) const {
 }
 
 // get first element
-template <typename value_type>
-typename Tiny::Vector<value_type>::val_reference
-Tiny::Vector<value_type>::front() {
+template <typename value_type, typename allocator_type, typename growth_policy>
+typename Tiny::Vector<value_type, allocator_type, growth_policy>::val_reference
+Tiny::Vector<value_type, allocator_type, growth_policy>::front() {
   return data_[0];
 }
 
 // get first element
-template <typename value_type>
-typename Tiny::Vector<value_type>::val_const_reference
-Tiny::Vector<value_type>::front() const {
+template <typename value_type, typename allocator_type, typename growth_policy>
+typename Tiny::Vector<value_type, allocator_type,
+                      growth_policy>::val_const_reference
+Tiny::Vector<value_type, allocator_type, growth_policy>::front() const {
   return data_[0];
 }
 
 // get last element
-template <typename value_type>
-typename Tiny::Vector<value_type>::val_reference
-Tiny::Vector<value_type>::back() {
+template <typename value_type, typename allocator_type, typename growth_policy>
+typename Tiny::Vector<value_type, allocator_type, growth_policy>::val_reference
+Tiny::Vector<value_type, allocator_type, growth_policy>::back() {
   return data_[size_ - 1];
 }
 
 // get last element
-template <typename value_type>
-typename Tiny::Vector<value_type>::val_const_reference
-Tiny::Vector<value_type>::back() const {
+template <typename value_type, typename allocator_type, typename growth_policy>
+typename Tiny::Vector<value_type, allocator_type,
+                      growth_policy>::val_const_reference
+Tiny::Vector<value_type, allocator_type, growth_policy>::back() const {
   return data_[size_ - 1];
 }
 
 // get data pointer
-template <typename value_type>
-typename Tiny::Vector<value_type>::val_const_pointer
-Tiny::Vector<value_type>::data() const {
+template <typename value_type, typename allocator_type, typename growth_policy>
+typename Tiny::Vector<value_type, allocator_type, growth_policy>::val_pointer
+Tiny::Vector<value_type, allocator_type, growth_policy>::data() {
+  return data_;
+}
+
+// get data pointer
+template <typename value_type, typename allocator_type, typename growth_policy>
+typename Tiny::Vector<value_type, allocator_type,
+                      growth_policy>::val_const_pointer
+Tiny::Vector<value_type, allocator_type, growth_policy>::data() const {
   return data_;
 }
 // ==== Element Access End Here ====
 
+// ==== Iterators Begin Here ====
+// iterators are plain pointers into the buffer
+template <typename value_type, typename allocator_type, typename growth_policy>
+typename Tiny::Vector<value_type, allocator_type, growth_policy>::iterator
+Tiny::Vector<value_type, allocator_type, growth_policy>::begin() {
+  return data_;
+}
+
+template <typename value_type, typename allocator_type, typename growth_policy>
+typename Tiny::Vector<value_type, allocator_type, growth_policy>::const_iterator
+Tiny::Vector<value_type, allocator_type, growth_policy>::begin() const {
+  return data_;
+}
+
+template <typename value_type, typename allocator_type, typename growth_policy>
+typename Tiny::Vector<value_type, allocator_type, growth_policy>::const_iterator
+Tiny::Vector<value_type, allocator_type, growth_policy>::cbegin() const {
+  return data_;
+}
+
+template <typename value_type, typename allocator_type, typename growth_policy>
+typename Tiny::Vector<value_type, allocator_type, growth_policy>::iterator
+Tiny::Vector<value_type, allocator_type, growth_policy>::end() {
+  return data_ + size_;
+}
+
+template <typename value_type, typename allocator_type, typename growth_policy>
+typename Tiny::Vector<value_type, allocator_type, growth_policy>::const_iterator
+Tiny::Vector<value_type, allocator_type, growth_policy>::end() const {
+  return data_ + size_;
+}
+
+template <typename value_type, typename allocator_type, typename growth_policy>
+typename Tiny::Vector<value_type, allocator_type, growth_policy>::const_iterator
+Tiny::Vector<value_type, allocator_type, growth_policy>::cend() const {
+  return data_ + size_;
+}
+// ==== Iterators End Here ====
+
+// ==== Stats Begin Here ====
+// what this object did to its storage so far
+template <typename value_type, typename allocator_type, typename growth_policy>
+Tiny::VectorStats
+Tiny::Vector<value_type, allocator_type, growth_policy>::stats() const {
+  return stats_.get();
+}
+// ==== Stats End Here ====
+
+// ==== Allocator Begin Here ====
+// get a copy of the allocator
+template <typename value_type, typename allocator_type, typename growth_policy>
+allocator_type
+Tiny::Vector<value_type, allocator_type, growth_policy>::get_allocator() const {
+  return alloc_;
+}
+// ==== Allocator End Here ====
+
 #endif // TINY_VECTOR_HPP
\ No newline at end of file
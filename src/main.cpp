@@ -1,5 +1,19 @@
 #include "MTest/test_Array.hpp"
+#include "MTest/test_BitVector.hpp"
+#include "MTest/test_ConcurrentQueue.hpp"
+#include "MTest/test_ConcurrentStack.hpp"
+#include "MTest/test_CowVector.hpp"
+#include "MTest/test_Expr.hpp"
+#include "MTest/test_MappedVector.hpp"
+#include "MTest/test_Matrix.hpp"
+#include "MTest/test_Parallel.hpp"
+#include "MTest/test_Queue.hpp"
+#include "MTest/test_RingBuffer.hpp"
 #include "MTest/test_SharedPtr.hpp"
+#include "MTest/test_Simd.hpp"
+#include "MTest/test_SmallVector.hpp"
+#include "MTest/test_SoAVector.hpp"
+#include "MTest/test_StableVector.hpp"
 #include "MTest/test_Thread.hpp"
 #include "MTest/test_UniquePtr.hpp"
 #include "MTest/test_Vector.hpp"
@@ -7,7 +21,32 @@
 int main() {
   Tiny::TestThread::test_Thread();
   Tiny::TestArray::test_Array();
+  Tiny::TestArray::test_Array_constexpr();
+  Tiny::TestExpr::test_Expr();
+  Tiny::TestMatrix::test_Matrix();
   Tiny::TestVector::test_Vector();
+  Tiny::TestVector::test_Vector_allocator();
+  Tiny::TestVector::test_Vector_relocate();
+  Tiny::TestVector::test_Vector_insert();
+  Tiny::TestVector::test_Vector_mmap();
+  Tiny::TestVector::test_Vector_aligned();
+  Tiny::TestVector::test_Vector_growth();
+  Tiny::TestSmallVector::test_SmallVector();
+  Tiny::TestStableVector::test_StableVector();
+  Tiny::TestSoAVector::test_SoAVector();
+  Tiny::TestBitVector::test_BitVector();
+  Tiny::TestCowVector::test_CowVector();
+  Tiny::TestMappedVector::test_MappedVector();
+  Tiny::TestQueue::test_Deque();
+  Tiny::TestQueue::test_Priority_Queue();
+  Tiny::TestQueue::test_Indexed_Priority_Queue();
+  Tiny::TestRingBuffer::test_RingBuffer();
+  Tiny::TestSimd::test_Simd();
+  Tiny::TestParallel::test_Parallel();
+  Tiny::TestConcurrentStack::test_ConcurrentStack();
+  Tiny::TestConcurrentQueue::test_SPSCQueue();
+  Tiny::TestConcurrentQueue::test_MPMCQueue();
+  Tiny::TestConcurrentQueue::test_BlockingQueue();
   Tiny::TestSharedPtr::test_SharedPtr_1();
   Tiny::TestSharedPtr::test_SharedPtr_2();
   Tiny::TestUniquePtr::test_UniquePtr();